@@ -316,11 +316,28 @@ saveValuesAtN()
   m_global_old_deltat = m_old_deltat;
   
   // synchronisation debut de pas de temps (avec projection nécéssaire ?)
-  m_pseudo_viscosity.synchronize();
-  m_density.synchronize();
-  m_internal_energy.synchronize();
-  m_cell_volume.synchronize();
-  m_pressure.synchronize();
+  if (options()->getLagrangeSyncVersion() == VS_bulksync_std) {
+    m_pseudo_viscosity.synchronize();
+    m_density.synchronize();
+    m_internal_energy.synchronize();
+    m_cell_volume.synchronize();
+    m_pressure.synchronize();
+  } else {
+    // Un seul échange par voisin pour toutes les variables multi-env
+    auto vsync = m_acc_env->vsyncMng();
+    MeshVariableSynchronizerList mvsl(vsync->bufAddrMng());
+    mvsl.add(m_pseudo_viscosity);
+    mvsl.add(m_density);
+    mvsl.add(m_internal_energy);
+    mvsl.add(m_cell_volume);
+    mvsl.add(m_pressure);
+
+    eVarSyncVersion mmat_version = VS_bulksync_evqueue;
+    if (options()->getLagrangeSyncVersion() == VS_overlap_evqueue_d && vsync->isDeviceAware()) {
+      mmat_version = VS_bulksync_evqueue_d;
+    }
+    vsync->multiMatSynchronize(mvsl, m_acc_env->refQueueAsync(), mmat_version);
+  }
 //   m_cell_cqs.synchronize();
 //   m_velocity.synchronize();
 
@@ -490,66 +507,58 @@ computeArtificialViscosity()
     }
   }
 #else
-  // Traitement des mailles pures tout environnement compris
-  // Pour ce faire, on boucle sur tout le maillage en initialisant à 0
-  // Si la maille est pure, il faut récupérer l'env_id pour adiabatic_cst
-  // A la fin de la boucle, toutes les mailles pures sont calculées 
-  // et les emplacements des grandeurs globales pour les mailles mixtes sont à 0
-  
-  auto queue = m_acc_env->newQueue();
-  queue.setAsync(true); // la queue est asynchrone par rapport à l'hôte, 
-  // cependant tous les kernels lancés sur cette queue s'exécutent séquentiellement les uns après les autres
-  // ici c'est primordial car le premier kernel va initialiser les grandeurs globales qui vont être mises 
-  // à jour environnement par environnement par les kernels suivants
+  // Les environnements sont indépendants les uns des autres :
+  // pour chaque env, les mailles pures (grandeurs globales) et les mailles
+  // mixtes (grandeurs partielles) sont calculées sur la queue de l'env
+  // puis un unique kernel sur les mailles mixtes calcule les moyennes
+  // Rappel : menv_queue->queue(*) sont des queues asynchrones indépendantes
+  MultiEnvCellStorage* menv_cell = m_acc_env->multiEnvCellStorage();
+  auto menv_queue = m_acc_env->multiEnvQueue();
 
-  {
-    auto command = makeCommand(queue);
+  ENUMERATE_ENV(ienv,mm){
+    IMeshEnvironment* env = *ienv;
 
-    auto in_env_id               = ax::viewIn(command, m_env_id);
-    auto in_div_u                = ax::viewIn(command, m_div_u);
-    auto in_caracteristic_length = ax::viewIn(command, m_caracteristic_length);
-    auto in_sound_speed          = ax::viewIn(command, m_sound_speed.globalVariable());
-    auto in_tau_density          = ax::viewIn(command, m_tau_density.globalVariable());
-    auto in_adiabatic_cst_env    = ax::viewIn(command, m_adiabatic_cst_env);
+    Real adiabatic_cst = m_adiabatic_cst_env(env->id());
 
-    auto out_pseudo_viscosity = ax::viewOut(command, m_pseudo_viscosity.globalVariable());
+    // Mailles pures de l'environnement
+    {
+      auto command = makeCommand(menv_queue->queue(env->id()));
 
-    command << RUNCOMMAND_ENUMERATE(Cell,cid,allCells()) {
-      out_pseudo_viscosity[cid] = 0.;
-      Integer env_id = in_env_id[cid]; // id de l'env si maille pure, <0 sinon
-      if (env_id>=0 && in_div_u[cid] < 0.0) {
+      auto in_div_u                = ax::viewIn(command, m_div_u);
+      auto in_caracteristic_length = ax::viewIn(command, m_caracteristic_length);
+      auto in_sound_speed          = ax::viewIn(command, m_sound_speed.globalVariable());
+      auto in_tau_density          = ax::viewIn(command, m_tau_density.globalVariable());
+
+      auto out_pseudo_viscosity = ax::viewOut(command, m_pseudo_viscosity.globalVariable());
+
+      Span<const Int32> in_pure_cells(menv_cell->pureCells(env->id()));
+      Integer nb_pur = in_pure_cells.size();
+
+      command << RUNCOMMAND_LOOP1(iter, nb_pur) {
+        auto [ipur] = iter(); // ipur \in [0,nb_pur[
+        CellLocalId cid(in_pure_cells[ipur]);
         CellLocalId ev_cid(cid); // exactement même valeur mais permet de distinguer ce qui relève du partiel et du global
-        Real adiabatic_cst = in_adiabatic_cst_env(env_id);
-        out_pseudo_viscosity[ev_cid] = 1. / in_tau_density[ev_cid]
-          * (-0.5 * in_caracteristic_length[cid] * in_sound_speed[cid] * in_div_u[cid]
-             + (adiabatic_cst + 1) / 2.0 * in_caracteristic_length[cid] * in_caracteristic_length[cid]
-             * in_div_u[cid] * in_div_u[cid]);
-      }
-    };
-  }
-  
-  // Traitement des mailles mixtes
-  // Pour chaque env traité l'un après l'autre, on récupère les mailles mixtes
-  // Pour chaque maille mixte, on calcule pseudo_viscosity 
-  // et on accumule cette valeur *fracvol dans la grandeur globale
-  ENUMERATE_ENV(ienv,mm){
-    IMeshEnvironment* env = *ienv;
+        out_pseudo_viscosity[ev_cid] = 0.;
+        if (in_div_u[cid] < 0.0) {
+          out_pseudo_viscosity[ev_cid] = 1. / in_tau_density[ev_cid]
+            * (-0.5 * in_caracteristic_length[cid] * in_sound_speed[cid] * in_div_u[cid]
+               + (adiabatic_cst + 1) / 2.0 * in_caracteristic_length[cid] * in_caracteristic_length[cid]
+               * in_div_u[cid] * in_div_u[cid]);
+        }
+      }; // asynchrone par rapport au CPU et aux autres queues
+    }
 
-    auto command = makeCommand(queue);
+    // Mailles mixtes de l'environnement, seules les valeurs partielles sont calculées
+    auto command = makeCommand(menv_queue->queue(env->id()));
 
-    Real adiabatic_cst = m_adiabatic_cst_env(env->id());
     auto in_div_u                = ax::viewIn(command, m_div_u);
     auto in_caracteristic_length = ax::viewIn(command, m_caracteristic_length);
     auto in_sound_speed          = ax::viewIn(command, m_sound_speed.globalVariable());
 
-    auto out_pseudo_viscosity = ax::viewOut(command, m_pseudo_viscosity.globalVariable());
-
     // Des sortes de vues sur les valeurs impures pour l'environnement env
-    Span<const Real>    in_fracvol(envView(m_fracvol, env));
     Span<const Integer> in_global_cell(envView(m_global_cell, env));
     Span<const Real>    in_tau_density(envView(m_tau_density, env));
-    Span<Real> inout_pseudo_viscosity(envView(m_pseudo_viscosity, env));
-
+    Span<Real> out_pseudo_viscosity(envView(m_pseudo_viscosity, env));
 
     // Nombre de mailles impures (mixtes) de l'environnement
     Integer nb_imp = env->impureEnvItems().nbItem();
@@ -558,21 +567,48 @@ computeArtificialViscosity()
       auto [imix] = iter(); // imix \in [0,nb_imp[
       CellLocalId cid(in_global_cell[imix]); // on récupère l'identifiant de la maille globale
 
-      // On calcule la valeur partielle sur la maille mixte
-      inout_pseudo_viscosity[imix] = 0.;
+      out_pseudo_viscosity[imix] = 0.;
       if (in_div_u[cid] < 0.0) {
-        inout_pseudo_viscosity[imix] = 1. / in_tau_density[imix]
+        out_pseudo_viscosity[imix] = 1. / in_tau_density[imix]
           * (-0.5 * in_caracteristic_length[cid] * in_sound_speed[cid] * in_div_u[cid]
              + (adiabatic_cst + 1) / 2.0 * in_caracteristic_length[cid] * in_caracteristic_length[cid]
              * in_div_u[cid] * in_div_u[cid]);
       }
+    }; // asynchrone par rapport au CPU et aux autres queues
+  }
+  menv_queue->waitAllQueues();
+
+  // Moyenne sur les mailles mixtes en une seule passe
+  auto queue = m_acc_env->newQueue();
+  {
+    auto command = makeCommand(queue);
+
+    MultiEnvVar<Real> menv_fracvol(m_fracvol, mm);
+    auto in_menv_fracvol(menv_fracvol.span());
+
+    MultiEnvVar<Real> menv_pseudo_viscosity(m_pseudo_viscosity, mm);
+    auto in_menv_pseudo_viscosity(menv_pseudo_viscosity.span());
+
+    auto out_pseudo_viscosity = ax::viewOut(command, m_pseudo_viscosity.globalVariable());
 
-      // Contribution à la grandeur globale, 
-      // out_pseudo_viscosity[cid] a été initialisée lors de la boucle sur maille pure
-      out_pseudo_viscosity[cid] += inout_pseudo_viscosity[imix] * in_fracvol[imix]; 
+    // Pour décrire l'accés multi-env sur GPU
+    auto in_menv_cell(menv_cell->viewIn(command));
+
+    Span<const Int32> in_mixed_cells(menv_cell->mixedCells());
+    Integer nb_mixed = in_mixed_cells.size();
+
+    command << RUNCOMMAND_LOOP1(iter, nb_mixed) {
+      auto [imix] = iter(); // imix \in [0,nb_mixed[
+      CellLocalId cid(in_mixed_cells[imix]);
+
+      Real pseudo_viscosity = 0.;
+      for(Integer ienv=0 ; ienv<in_menv_cell.nbEnv(cid) ; ++ienv) {
+        auto evi = in_menv_cell.envCell(cid,ienv);
+        pseudo_viscosity += in_menv_pseudo_viscosity[evi] * in_menv_fracvol[evi];
+      }
+      out_pseudo_viscosity[cid] = pseudo_viscosity;
     };
   }
-  queue.barrier(); // attente de fin des exécutions sur GPU
 #endif
   PROF_ACC_END;
 }
@@ -622,9 +658,15 @@ updateForceAndVelocity(Real dt,
     SimdNode snode=*inode;
     out_velocity[snode] = in_velocity[snode] + ( dt / in_mass[snode]) * in_force[snode];;
   }
+  v_velocity_out.synchronize();
 #else
-  {
-    auto queue = m_acc_env->newQueue();
+  auto node_index_in_cells = m_acc_env->nodeIndexInCells();
+  const Integer max_node_cell = m_acc_env->maxNodeCell();
+
+  auto nc_cty = m_acc_env->connectivityView().nodeCell();
+
+  // Calcul de la force et de la vitesse sur le groupe de noeuds nodes
+  auto compute_force_and_velocity = [&](NodeGroup nodes, RunQueue* queue) {
     auto command = makeCommand(queue);
 
     auto in_pressure         = ax::viewIn(command, v_pressure.globalVariable());
@@ -633,16 +675,11 @@ updateForceAndVelocity(Real dt,
     // TODO : supprimer m_force, qui ne devient qu'une variable temporaire de travail
     auto out_force           = ax::viewOut(command, m_force);
 
-    auto node_index_in_cells = m_acc_env->nodeIndexInCells();
-    const Integer max_node_cell = m_acc_env->maxNodeCell();
-
-    auto nc_cty = m_acc_env->connectivityView().nodeCell();
-
     auto in_mass      = ax::viewIn(command, m_node_mass);
     auto in_velocity  = ax::viewIn(command, v_velocity_in);
     auto out_velocity = ax::viewOut(command, v_velocity_out);
     
-    command << RUNCOMMAND_ENUMERATE(Node,nid,allNodes()) {
+    command << RUNCOMMAND_ENUMERATE(Node,nid,nodes) {
       Int32 first_pos = nid.localId() * max_node_cell;
       Integer index = 0;
       Real3 node_force = Real3::zero();
@@ -657,10 +694,13 @@ updateForceAndVelocity(Real dt,
       // On peut mettre la vitesse à jour dans la foulée
       out_velocity[nid] = in_velocity[nid] + ( dt / in_mass[nid]) * node_force;
     };
-  }
-#endif
+  };
 
-  v_velocity_out.synchronize();
+  // Calcul sur les noeuds "own" puis maj des noeuds fantômes de v_velocity_out,
+  // en recouvrant éventuellement les comms par le calcul des noeuds intérieurs
+  m_acc_env->vsyncMng()->computeAndSync(compute_force_and_velocity, v_velocity_out,
+      options()->getLagrangeSyncVersion());
+#endif
   PROF_ACC_END;
 }
 
@@ -889,7 +929,25 @@ updatePosition()
   }
 #else
   auto queue = m_acc_env->newQueue();
-  if (!options()->sansLagrange)
+  if (!options()->sansLagrange && options()->getLagrangeSyncVersion() != VS_bulksync_std)
+  {
+    // Déplacement des noeuds "own" puis maj des noeuds fantômes,
+    // computeGeometricValues() n'aura pas à synchroniser m_node_coord
+    auto move_nodes = [&](NodeGroup nodes, RunQueue* node_queue) {
+      auto command = makeCommand(node_queue);
+
+      auto in_velocity    = ax::viewIn(command,m_velocity);
+      auto out_node_coord = ax::viewInOut(command,m_node_coord);
+
+      command << RUNCOMMAND_ENUMERATE(Node,nid,nodes) {
+        out_node_coord[nid] += deltat * in_velocity[nid];
+      };
+    };
+    m_acc_env->vsyncMng()->computeAndSync(move_nodes, m_node_coord,
+        options()->getLagrangeSyncVersion());
+    m_node_coord_synced = true;
+  }
+  else if (!options()->sansLagrange)
   {
     auto command = makeCommand(queue);
 
@@ -1057,7 +1115,11 @@ computeGeometricValues()
   PROF_ACC_BEGIN(__FUNCTION__);
   debug() << my_rank << " : " << " Entree dans computeGeometricValues() ";
   
-  m_node_coord.synchronize();
+  // Inutile si updatePosition() a déjà synchronisé les coordonnées
+  if (!m_node_coord_synced) {
+    m_node_coord.synchronize();
+  }
+  m_node_coord_synced = false;
   if ( m_dimension == 3) {
     {
       auto queue = m_acc_env->newQueue();
@@ -1466,16 +1528,46 @@ updateEnergyAndPressure()
   // Moyennes reportées dans updateEnergyAndPressurebyNewton() et updateEnergyAndPressureforGP()
 #endif
   if (! options()->withProjection) {
-    // Calcul de la Pression si on ne fait pas de projection 
-    for( Integer i=0,n=options()->environment().size(); i<n; ++i ) {
-        IMeshEnvironment* ienv = mm->environments()[i];
-        // Calcul de la pression et de la vitesse du son
-        options()->environment[i].eosModel()->applyEOS(ienv);
-    }
+    // Calcul de la Pression et de la vitesse du son si on ne fait pas de projection 
+    _applyEOSAllEnv();
     computePressionMoyenne();
   }
   PROF_ACC_END;
 }
+/*---------------------------------------------------------------------------*/
+/* Newton sur toutes les valeurs d'un environnement à la fois                */
+/* L'EOS est appliquée par lot (applyEOSValues) et chaque valeur converge    */
+/* indépendamment : un masque fige les valeurs déjà convergées               */
+/* residual(i,e,p,dpde) et deriv(i,e,p,dpde) : fonction et dérivée en i      */
+/*---------------------------------------------------------------------------*/
+template<typename ResidualFunc, typename DerivFunc>
+void solve_newton_eos(IEquationOfState* eos, IMeshEnvironment* env,
+    Real epsilon, Integer itermax,
+    Span<const Real> density, Span<Real> e,
+    Span<Real> p, Span<Real> c, Span<Real> dpde,
+    ResidualFunc residual, DerivFunc deriv)
+{
+  Int64 nb_val = e.size();
+  UniqueArray<Byte> active(nb_val);
+  active.fill(1);
+
+  Int64 nb_active = nb_val;
+  for (Integer iter = 0; iter < itermax && nb_active > 0; ++iter) {
+    // Les valeurs convergées ne changent plus, l'EOS y redonne les mêmes p, c, dpde
+    eos->applyEOSValues(env, density, e, p, c, dpde);
+
+    nb_active = 0;
+    for (Int64 i = 0; i < nb_val; ++i) {
+      Real res = residual(i, e[i], p[i], dpde[i]);
+      bool is_active = active[i] && math::abs(res) >= epsilon;
+      if (is_active)
+        e[i] -= res / deriv(i, e[i], p[i], dpde[i]);
+      active[i] = is_active;
+      nb_active += is_active;
+    }
+  }
+}
+
 /*
  *******************************************************************************
 */
@@ -1486,12 +1578,21 @@ void MahycoModule::updateEnergyAndPressurebyNewton()  {
     debug() << " Entree dans updateEnergyAndPressure()";
     bool csts = options()->schemaCsts();
     bool pseudo_centree = options()->pseudoCentree();
+    // les iterations de newton
+    Real epsilon = options()->threshold;
+    Integer itermax = 50;
     // Calcul de l'énergie interne
     if (!csts) {
       ENUMERATE_ENV(ienv,mm){
         IMeshEnvironment* env = *ienv;
-        Real adiabatic_cst = options()->environment[env->id()].eosModel()->getAdiabaticCst(env);
-        Real tension_limit = options()->environment[env->id()].eosModel()->getTensionLimitCst(env);
+        IEquationOfState* eos = options()->environment[env->id()].eosModel();
+
+        // Valeurs de l'environnement rangées dans l'ordre de ENUMERATE_ENVCELL
+        Integer nb_val = env->envView().nbItem();
+        RealUniqueArray rn(nb_val), pn(nb_val), qnn1(nb_val), rn1(nb_val), en(nb_val);
+        RealUniqueArray e(nb_val), p(nb_val), c(nb_val), dpde(nb_val);
+
+        Integer i = 0;
         ENUMERATE_ENVCELL(ienvcell,env){
           EnvCell ev = *ienvcell;
           Real pseudo(0.);
@@ -1502,34 +1603,31 @@ void MahycoModule::updateEnergyAndPressurebyNewton()  {
                 (m_pseudo_viscosity[ev] * (1.0 / m_density[ev] - 1.0 / m_density_n[ev]) < 0.))
             pseudo = m_pseudo_viscosity[ev];
             
-          double rn  = m_density_n[ev];
-          double pn  = m_pressure_n[ev];
-          double qnn1 = pseudo;
-          double m   = m_cell_mass[ev];
-          double rn1 = m_density[ev];
-          double en  = m_internal_energy_n[ev];
-          double g = adiabatic_cst;
-          double t = tension_limit;
-          // les iterations denewton
-          double epsilon = options()->threshold;
-          double itermax = 50;
-          double enew=0, e=en, p, c, dpde;
-          int i = 0;
-        
-          while(i<itermax && abs(fvnr(e, p, dpde, en, qnn1, pn, rn1, rn))>=epsilon)
-            {
-              m_internal_energy[ev] = e;
-              options()->environment[env->id()].eosModel()->applyOneCellEOS(env, ev);
-              p = m_pressure[ev];
-              c = m_sound_speed[ev];
-              dpde = m_dpde[ev];
-              enew = e - fvnr(e, p, dpde, en, qnn1, pn, rn1, rn) / fvnrderiv(e, dpde, rn1, rn);
-              e = enew;
-              i++;
-            }
-          m_internal_energy[ev] = e;
-	      m_sound_speed[ev] = c;
-	      m_pressure[ev] = p;
+          rn[i]   = m_density_n[ev];
+          pn[i]   = m_pressure_n[ev];
+          qnn1[i] = pseudo;
+          rn1[i]  = m_density[ev];
+          en[i]   = m_internal_energy_n[ev];
+          e[i]    = en[i];
+          ++i;
+        }
+
+        solve_newton_eos(eos, env, epsilon, itermax, rn1, e, p, c, dpde,
+            [&](Int64 k, Real ek, Real pk, Real dpdek) {
+              return fvnr(ek, pk, dpdek, en[k], qnn1[k], pn[k], rn1[k], rn[k]);
+            },
+            [&](Int64 k, Real ek, Real pk, Real dpdek) {
+              return fvnrderiv(ek, dpdek, rn1[k], rn[k]);
+            });
+
+        i = 0;
+        ENUMERATE_ENVCELL(ienvcell,env){
+          EnvCell ev = *ienvcell;
+          m_internal_energy[ev] = e[i];
+          m_sound_speed[ev] = c[i];
+          m_pressure[ev] = p[i];
+          m_dpde[ev] = dpde[i];
+          ++i;
         }
       }
       // maille mixte
@@ -1548,10 +1646,20 @@ void MahycoModule::updateEnergyAndPressurebyNewton()  {
         }
       }
     } else {
+      Real deltat = m_global_deltat();
+      Real old_deltat = m_global_old_deltat();
       ENUMERATE_ENV(ienv,mm){
         IMeshEnvironment* env = *ienv;
-        Real adiabatic_cst = options()->environment[env->id()].eosModel()->getAdiabaticCst(env);
-        Real tension_limit = options()->environment[env->id()].eosModel()->getTensionLimitCst(env);
+        IEquationOfState* eos = options()->environment[env->id()].eosModel();
+
+        // Valeurs de l'environnement rangées dans l'ordre de ENUMERATE_ENVCELL
+        Integer nb_val = env->envView().nbItem();
+        RealUniqueArray pn(nb_val), qn(nb_val), qn1(nb_val), m(nb_val), rn1(nb_val), en(nb_val);
+        RealUniqueArray cn1(nb_val), cn(nb_val), cdn(nb_val), qnm1(nb_val);
+        RealUniqueArray e(nb_val), p(nb_val), c(nb_val), dpde(nb_val);
+        Real cdon = 0.;
+
+        Integer i = 0;
         ENUMERATE_ENVCELL(ienvcell,env){
           EnvCell ev = *ienvcell;
           Cell cell=ev.globalCell();
@@ -1561,48 +1669,44 @@ void MahycoModule::updateEnergyAndPressurebyNewton()  {
           Real cqs_v_old_n(0.);
           for (Integer inode = 0; inode < cell.nbNode(); ++inode) {
             cqs_v_nplus1 += math::dot(m_velocity[cell.node(inode)], m_cell_cqs[cell] [inode])
-              * m_global_deltat();
+              * deltat;
             cqs_v_n += math::dot(m_velocity[cell.node(inode)], m_cell_cqs_n[cell] [inode])
-              * m_global_deltat();
+              * deltat;
             cqs_delta_v +=  math::dot(m_velocity[cell.node(inode)] - m_velocity_n[cell.node(inode)], m_cell_cqs_n[cell] [inode])
-            * (m_global_deltat() - m_global_old_deltat());
+            * (deltat - old_deltat);
             cqs_v_old_n += math::dot(m_velocity_n[cell.node(inode)], m_cell_cqs_n[cell] [inode])
-            * m_global_old_deltat();
+            * old_deltat;
           }
-          double rn  = m_density_n[ev];
-          double pn  = m_pressure_n[ev];
-          double qn = m_pseudo_viscosity_n[ev];
-          double qn1 = m_pseudo_viscosity[ev];
-          double m   = m_cell_mass[ev];
-          double rn1 = m_density[ev];
-          double en  = m_internal_energy_n[ev];
-          double g = adiabatic_cst;
-          double t = tension_limit;
-          double cn1 = cqs_v_nplus1;
-          double cn = cqs_v_n;
-          double cdn = cqs_delta_v;
-          double cdon = 0. ;
-          double qnm1 = m_pseudo_viscosity_nmoins1[ev]; 
-          // les iterations de newton
-          double epsilon = options()->threshold;
-          double itermax = 50;
-          double enew=0, e=en, p, c, dpde;
-          int i = 0;
-        
-          while(i<itermax && abs(f(e, p, dpde, en, qn, pn, cn1, cn, m, qn1, cdn, cdon, qnm1))>=epsilon)
-	        {
-              m_internal_energy[ev] = e;
-              options()->environment[env->id()].eosModel()->applyOneCellEOS(env, ev);
-              p = m_pressure[ev];
-              c = m_sound_speed[ev];
-              dpde = m_dpde[ev];
-              enew = e - f(e, p, dpde, en, qn, pn, cn1, cn, m, qn1, cdn, cdon, qnm1) / fderiv(e, p, dpde, cn1, m);
-              e = enew;
-              i++;
-            }
-          m_internal_energy[ev] = e;
-	      m_sound_speed[ev] = c;
-	      m_pressure[ev] = p;
+          pn[i]   = m_pressure_n[ev];
+          qn[i]   = m_pseudo_viscosity_n[ev];
+          qn1[i]  = m_pseudo_viscosity[ev];
+          m[i]    = m_cell_mass[ev];
+          rn1[i]  = m_density[ev];
+          en[i]   = m_internal_energy_n[ev];
+          cn1[i]  = cqs_v_nplus1;
+          cn[i]   = cqs_v_n;
+          cdn[i]  = cqs_delta_v;
+          qnm1[i] = m_pseudo_viscosity_nmoins1[ev]; 
+          e[i]    = en[i];
+          ++i;
+        }
+
+        solve_newton_eos(eos, env, epsilon, itermax, rn1, e, p, c, dpde,
+            [&](Int64 k, Real ek, Real pk, Real dpdek) {
+              return f(ek, pk, dpdek, en[k], qn[k], pn[k], cn1[k], cn[k], m[k], qn1[k], cdn[k], cdon, qnm1[k]);
+            },
+            [&](Int64 k, Real ek, Real pk, Real dpdek) {
+              return fderiv(ek, pk, dpdek, cn1[k], m[k]);
+            });
+
+        i = 0;
+        ENUMERATE_ENVCELL(ienvcell,env){
+          EnvCell ev = *ienvcell;
+          m_internal_energy[ev] = e[i];
+          m_sound_speed[ev] = c[i];
+          m_pressure[ev] = p[i];
+          m_dpde[ev] = dpde[i];
+          ++i;
         }
       }
       // maille mixte
@@ -1692,47 +1796,46 @@ updateEnergyAndPressureforGP()
       }
     }
 #else
-    // Traitements dépendants des mailles pures/globales 
-    // puis des mailles mixtes qui vont mettre à jour les valeurs globales
+    // Les environnements sont indépendants les uns des autres :
+    // pour chaque env, les mailles pures (grandeurs globales) et les mailles
+    // mixtes (grandeurs partielles) sont calculées sur la queue de l'env
+    // puis un unique kernel sur les mailles mixtes calcule les moyennes
+    MultiEnvCellStorage* menv_cell = m_acc_env->multiEnvCellStorage();
+    auto menv_queue = m_acc_env->multiEnvQueue();
 
-    auto queue = m_acc_env->newQueue();
-    // Traitement des mailles pures via les tableaux .globalVariable()
-    {
-      auto command = makeCommand(queue);
+    ENUMERATE_ENV(ienv,mm){
+      IMeshEnvironment* env = *ienv;
+
+      Real adiabatic_cst = m_adiabatic_cst_env(env->id());
 
-      auto in_env_id               = ax::viewIn(command, m_env_id);
-      auto in_adiabatic_cst_env    = ax::viewIn(command, m_adiabatic_cst_env);
+      // Mailles pures de l'environnement via les tableaux .globalVariable()
+      {
+        auto command = makeCommand(menv_queue->queue(env->id()));
+
+        auto in_pseudo_viscosity_n   = ax::viewIn(command, m_pseudo_viscosity_n.globalVariable()); 
+        auto in_pseudo_viscosity     = ax::viewIn(command, m_pseudo_viscosity.globalVariable());
+        auto in_density_n            = ax::viewIn(command, m_density_n.globalVariable()); 
+        auto in_density              = ax::viewIn(command, m_density.globalVariable()); 
+        auto in_pressure             = ax::viewIn(command, m_pressure.globalVariable()); 
+        auto in_internal_energy_n    = ax::viewIn(command, m_internal_energy_n.globalVariable());
 
-      auto in_pseudo_viscosity_n   = ax::viewIn(command, m_pseudo_viscosity_n.globalVariable()); 
-      auto in_pseudo_viscosity     = ax::viewIn(command, m_pseudo_viscosity.globalVariable());
-      auto in_density_n            = ax::viewIn(command, m_density_n.globalVariable()); 
-      auto in_density              = ax::viewIn(command, m_density.globalVariable()); 
-      auto in_pressure             = ax::viewIn(command, m_pressure.globalVariable()); 
-      auto in_internal_energy_n    = ax::viewIn(command, m_internal_energy_n.globalVariable());
+        auto out_internal_energy     = ax::viewOut(command, m_internal_energy.globalVariable());
 
-      auto out_internal_energy     = ax::viewOut(command, m_internal_energy.globalVariable());
+        Span<const Int32> in_pure_cells(menv_cell->pureCells(env->id()));
+        Integer nb_pur = in_pure_cells.size();
 
-      command << RUNCOMMAND_ENUMERATE(Cell,cid,allCells()) {
-        out_internal_energy[cid] = 0.; // initialisation pour une future maj des mailles moyennes (globales)
-        Integer env_id = in_env_id[cid]; // id de l'env si maille pure, <0 sinon
-        if (env_id>=0) { // vrai ssi cid maille pure
-          Real adiabatic_cst = in_adiabatic_cst_env(env_id);
-          CellLocalId ev_cid(cid); // exactement même valeur mais met en évidence le caractère "environnement" de la maille pure
+        command << RUNCOMMAND_LOOP1(iter, nb_pur) {
+          auto [ipur] = iter(); // ipur \in [0,nb_pur[
+          CellLocalId ev_cid(in_pure_cells[ipur]); // met en évidence le caractère "environnement" de la maille pure
           out_internal_energy[ev_cid] = compute_eint(pseudo_centree, adiabatic_cst,
               in_pseudo_viscosity_n[ev_cid], in_pseudo_viscosity[ev_cid],
               in_density_n[ev_cid], in_density[ev_cid], 
               in_pressure[ev_cid], in_internal_energy_n[ev_cid]);
-        }
-      }; // non-bloquant
-    }
-
-    // Traitement des mailles mixtes via les envView(...)
-
-    ENUMERATE_ENV(ienv,mm){
-      IMeshEnvironment* env = *ienv;
+        }; // asynchrone par rapport au CPU et aux autres queues
+      }
 
-      // Les kernels sont lancés environnement par environnement les uns après les autres
-      auto command = makeCommand(queue);
+      // Mailles mixtes de l'environnement via les envView(...)
+      auto command = makeCommand(menv_queue->queue(env->id()));
 
       Span<const Real> in_pseudo_viscosity_n(envView(m_pseudo_viscosity_n, env)); 
       Span<const Real> in_pseudo_viscosity  (envView(m_pseudo_viscosity, env));
@@ -1740,31 +1843,52 @@ updateEnergyAndPressureforGP()
       Span<const Real> in_density           (envView(m_density, env)); 
       Span<const Real> in_pressure          (envView(m_pressure, env)); 
       Span<const Real> in_internal_energy_n (envView(m_internal_energy_n, env));
-      Span<const Real> in_mass_fraction     (envView(m_mass_fraction, env));
-      Span<const Integer> in_global_cell    (envView(m_global_cell, env));
 
       Span<Real> out_internal_energy        (envView(m_internal_energy, env));
-      auto inout_internal_energy_g = ax::viewInOut(command, m_internal_energy.globalVariable());
-
-      Real adiabatic_cst = m_adiabatic_cst_env(env->id());
 
       // Nombre de mailles impures (mixtes) de l'environnement
       Integer nb_imp = env->impureEnvItems().nbItem();
 
       command << RUNCOMMAND_LOOP1(iter, nb_imp) {
         auto [imix] = iter(); // imix \in [0,nb_imp[
-        CellLocalId cid(in_global_cell[imix]); // on récupère l'identifiant de la maille globale
 
-        Real internal_energy = compute_eint(pseudo_centree, adiabatic_cst,
+        out_internal_energy[imix] = compute_eint(pseudo_centree, adiabatic_cst,
             in_pseudo_viscosity_n[imix], in_pseudo_viscosity[imix],
             in_density_n[imix], in_density[imix], 
             in_pressure[imix], in_internal_energy_n[imix]);
+      }; // asynchrone par rapport au CPU et aux autres queues
+    }
+    menv_queue->waitAllQueues();
+
+    // Moyenne (ie grandeur globale) sur les mailles mixtes en une seule passe
+    auto queue = m_acc_env->newQueue();
+    {
+      auto command = makeCommand(queue);
+
+      MultiEnvVar<Real> menv_mass_fraction(m_mass_fraction, mm);
+      auto in_menv_mass_fraction(menv_mass_fraction.span());
 
-        out_internal_energy[imix] = internal_energy;
+      MultiEnvVar<Real> menv_internal_energy(m_internal_energy, mm);
+      auto in_menv_internal_energy(menv_internal_energy.span());
 
-        // Maj de la grandeur global (ie moyenne)
-        // inout_internal_energy_g[cid] a été initialisée à 0 par le kernel sur les grandeurs globales
-        inout_internal_energy_g[cid] += in_mass_fraction[imix] * internal_energy;
+      auto out_internal_energy_g = ax::viewOut(command, m_internal_energy.globalVariable());
+
+      // Pour décrire l'accés multi-env sur GPU
+      auto in_menv_cell(menv_cell->viewIn(command));
+
+      Span<const Int32> in_mixed_cells(menv_cell->mixedCells());
+      Integer nb_mixed = in_mixed_cells.size();
+
+      command << RUNCOMMAND_LOOP1(iter, nb_mixed) {
+        auto [imix] = iter(); // imix \in [0,nb_mixed[
+        CellLocalId cid(in_mixed_cells[imix]);
+
+        Real internal_energy = 0.;
+        for(Integer ienv=0 ; ienv<in_menv_cell.nbEnv(cid) ; ++ienv) {
+          auto evi = in_menv_cell.envCell(cid,ienv);
+          internal_energy += in_menv_mass_fraction[evi] * in_menv_internal_energy[evi];
+        }
+        out_internal_energy_g[cid] = internal_energy;
       }; // bloquant
     }
 #endif
@@ -1824,6 +1948,40 @@ updateEnergyAndPressureforGP()
   }
   PROF_ACC_END;
 }   
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MahycoModule::
+_applyEOSAllEnv()
+{
+  PROF_ACC_BEGIN(__FUNCTION__);
+  // Rappel : menv_queue->queue(*) sont des queues asynchrones indépendantes
+  auto menv_queue = m_acc_env->multiEnvQueue();
+
+  if (AcceleratorUtils::isAvailable(m_acc_env->runner())) {
+    // Les kernels de tous les environnements sont lancés sans attente
+    ENUMERATE_ENV(ienv,mm){
+      IMeshEnvironment* env = *ienv;
+      options()->environment[env->id()].eosModel()->asyncApplyEOS(env, menv_queue->queue(env->id()));
+    }
+    menv_queue->waitAllQueues();
+  } else {
+    // Sur CPU, un kernel s'exécute dès son lancement : pour que les
+    // environnements soient traités en même temps, chacun est confié à une
+    // tâche. Les RunCommand ne pouvant pas être lancées depuis plusieurs
+    // threads, chaque tâche fait de simples boucles sur l'hôte.
+    ConstArrayView<IMeshEnvironment*> envs = mm->environments();
+    ParallelLoopOptions mtopt;
+    mtopt.setGrainSize(1);
+    arcaneParallelFor(0, envs.size(), mtopt, [&](Integer begin, Integer size) {
+      for (Integer index_env = begin; index_env < begin+size; ++index_env) {
+        options()->environment[index_env].eosModel()->hostApplyEOS(envs[index_env]);
+      }
+    });
+  }
+  PROF_ACC_END;
+}
+
 /**
  *******************************************************************************
  * \file computePressionMoyenne()
@@ -1859,55 +2017,46 @@ computePressionMoyenne()
 #else
   m_acc_env->checkMultiEnvGlobalCellId(mm);
 
-  // Pas très efficace mais on va lancer un kernel sur tout le maillage pour
-  // ne sélectionner que les mailles mixtes et initialiser les grandeus
-  // moyennes
-  // puis on va calculer les grandeurs partielles environnement par
-  // environnement et mettre à jour au fur et à mesure les grandeurs moy.
-
-  // Toutes les étapes doivent se faire les unes après les autres d'où une
-  // queue unique
+  // Un unique kernel sur la liste compacte des mailles mixtes calcule en
+  // une seule passe les grandeurs moyennes à partir des grandeurs partielles
+  // de tous les environnements de la maille
+  MultiEnvCellStorage* menv_cell = m_acc_env->multiEnvCellStorage();
   auto queue = m_acc_env->newQueue();
   {
     auto command = makeCommand(queue);
 
-    auto in_env_id       = ax::viewIn(command, m_env_id);
-    auto out_pressure    = ax::viewOut(command, m_pressure.globalVariable());
-    auto out_sound_speed = ax::viewOut(command, m_sound_speed.globalVariable());
+    MultiEnvVar<Real> menv_fracvol(m_fracvol, mm);
+    auto in_menv_fracvol(menv_fracvol.span());
 
-    command << RUNCOMMAND_ENUMERATE(Cell,cid,allCells()) {
-      Integer env_id = in_env_id[cid]; // id de l'env si maille pure, <0 sinon
+    MultiEnvVar<Real> menv_pressure(m_pressure, mm);
+    auto in_menv_pressure(menv_pressure.span());
 
-      if (env_id<0) { // vrai si maille mixte (nbEnv() == -env_id-1)
-        out_pressure[cid] = 0.;
-        out_sound_speed[cid] = 1.e-20;
-      }
-    };
-  }
- 
-  ENUMERATE_ENV(ienv,mm){
-    IMeshEnvironment* env = *ienv;
+    MultiEnvVar<Real> menv_sound_speed(m_sound_speed, mm);
+    auto in_menv_sound_speed(menv_sound_speed.span());
 
-    // Les kernels sont lancés environnement par environnement les uns après les autres
-    auto command = makeCommand(queue);
-    
-    Span<const Integer> in_global_cell    (envView(m_global_cell, env));
-    Span<const Real>    in_fracvol        (envView(m_fracvol,     env)); 
-    Span<const Real>    in_pressure       (envView(m_pressure,    env)); 
-    Span<const Real>    in_sound_speed    (envView(m_sound_speed, env)); 
+    auto out_pressure    = ax::viewOut(command, m_pressure.globalVariable());
+    auto out_sound_speed = ax::viewOut(command, m_sound_speed.globalVariable());
 
-    auto inout_pressure    = ax::viewInOut(command, m_pressure.globalVariable());
-    auto inout_sound_speed = ax::viewInOut(command, m_sound_speed.globalVariable());
+    // Pour décrire l'accés multi-env sur GPU
+    auto in_menv_cell(menv_cell->viewIn(command));
 
-    // Nombre de mailles impures (mixtes) de l'environnement
-    Integer nb_imp = env->impureEnvItems().nbItem();
+    // Mailles telles que env_id<0 (nbEnv() == -env_id-1)
+    Span<const Int32> in_mixed_cells(menv_cell->mixedCells());
+    Integer nb_mixed = in_mixed_cells.size();
 
-    command << RUNCOMMAND_LOOP1(iter, nb_imp) {
-      auto [imix] = iter(); // imix \in [0,nb_imp[
-      CellLocalId cid(in_global_cell[imix]); // on récupère l'identifiant de la maille globale
+    command << RUNCOMMAND_LOOP1(iter, nb_mixed) {
+      auto [imix] = iter(); // imix \in [0,nb_mixed[
+      CellLocalId cid(in_mixed_cells[imix]);
 
-      inout_pressure[cid] += in_fracvol[imix] * in_pressure[imix];
-      inout_sound_speed[cid] = math::max(in_sound_speed[imix], inout_sound_speed[cid]);
+      Real pressure = 0.;
+      Real sound_speed = 1.e-20;
+      for(Integer ienv=0 ; ienv<in_menv_cell.nbEnv(cid) ; ++ienv) {
+        auto evi = in_menv_cell.envCell(cid,ienv);
+        pressure += in_menv_fracvol[evi] * in_menv_pressure[evi];
+        sound_speed = math::max(in_menv_sound_speed[evi], sound_speed);
+      }
+      out_pressure[cid] = pressure;
+      out_sound_speed[cid] = sound_speed;
     };
   }
 #endif
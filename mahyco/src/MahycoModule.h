@@ -405,6 +405,12 @@ class MahycoModule
    */
   void _initBoundaryConditionsForAcc();
 
+  /** Applique l'équation d'état de tous les environnements en même temps :
+   *  une queue de multiEnvQueue() par environnement sur accélérateur,
+   *  une tâche par environnement sur CPU, une seule attente à la fin
+   */
+  void _applyEOSAllEnv();
+
   /** Construit le maillage cartésien et les managers par direction
    */
   CartesianInterface::ICartesianMesh* _initCartMesh();
@@ -453,6 +459,9 @@ class MahycoModule
   // Pour l'utilisation des accélérateurs
   IAccEnv* m_acc_env=nullptr;
 
+  // Vrai si m_node_coord a été synchronisée par updatePosition()
+  bool m_node_coord_synced=false;
+
   UniqueArray<BoundaryCondition> m_boundary_conditions;
 
   // Va contenir eosModel()->getAdiabaticCst(env), accessible à la fois sur CPU et GPU
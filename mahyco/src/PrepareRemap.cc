@@ -551,11 +551,8 @@ void MahycoModule::remap() {
 #endif
    
     if (!options()->sansLagrange) {
-      for (Integer index_env=0; index_env < m_nb_env ; index_env++) {
-        IMeshEnvironment* ienv = mm->environments()[index_env];
-        // Calcul de la pression et de la vitesse du son
-        options()->environment[index_env].eosModel()->applyEOS(ienv);
-      }
+      // Calcul de la pression et de la vitesse du son
+      _applyEOSAllEnv();
       computePressionMoyenne();
    }
     PROF_ACC_END;
@@ -343,10 +343,14 @@ void RemapADIService::computeDualUremap(Integer idir, Integer nb_env)  {
 #endif
 
   // doit etre inutile si on augmente le nombre de mailles fantomes
-  m_back_flux_mass_env.synchronize(); 
-  m_front_flux_mass_env.synchronize();
-  m_back_flux_mass.synchronize(); 
-  m_front_flux_mass.synchronize();
+  {
+    MeshVariableSynchronizerList mvsl(m_acc_env->vsyncMng()->bufAddrMng());
+    mvsl.add(m_back_flux_mass_env);
+    mvsl.add(m_front_flux_mass_env);
+    mvsl.add(m_back_flux_mass);
+    mvsl.add(m_front_flux_mass);
+    m_acc_env->vsyncMng()->globalSynchronize(mvsl);
+  }
     
 #if 1
   {
@@ -683,8 +687,10 @@ void RemapADIService::computeDualUremap(Integer idir, Integer nb_env)  {
  */
 void RemapADIService::synchronizeDualUremap()  {
     debug() << " Entree dans synchronizeUremap()";
-    m_phi_dual_lagrange.synchronize();
-    m_u_dual_lagrange.synchronize();
+    MeshVariableSynchronizerList mvsl(m_acc_env->vsyncMng()->bufAddrMng());
+    mvsl.add(m_phi_dual_lagrange);
+    mvsl.add(m_u_dual_lagrange);
+    m_acc_env->vsyncMng()->globalSynchronize(mvsl);
 }
 
 
@@ -107,6 +107,8 @@ void RemapADIService::remapVariables(Integer dimension, Integer withDualProjecti
     // Pour décrire l'accés multi-env sur GPU
     auto in_menv_cell(m_acc_env->multiEnvCellStorage()->viewIn(command));
 
+    // Toutes les mailles sont parcourues (et non mixedCells()) : une maille
+    // pure d'un autre env peut entrer dans l'env index_env
     command.addKernelName("add_rm") << RUNCOMMAND_ENUMERATE(Cell,cid,allCells())
     {
       Real fvol = in_u_lagrange[cid][index_env] / in_euler_volume[cid];
@@ -443,6 +445,9 @@ void RemapADIService::remapVariables(Integer dimension, Integer withDualProjecti
     // Pour décrire l'accés multi-env sur GPU
     auto in_menv_cell(m_acc_env->multiEnvCellStorage()->viewIn(command));
 
+    // Toutes les mailles sont parcourues (et non mixedCells()) : les grandeurs
+    // globales sont recalculées sur chaque maille et une maille pure peut
+    // devenir mixte
     command.addKernelName("moy") << RUNCOMMAND_ENUMERATE(Cell,cid,allCells())
     {
       Real vol = in_euler_volume[cid];  // volume euler   
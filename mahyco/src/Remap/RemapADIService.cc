@@ -20,7 +20,14 @@ void RemapADIService::appliRemap(Integer dimension, Integer withDualProjection,
     
     PROF_ACC_BEGIN(__FUNCTION__);
     synchronizeUremap();  
-    synchronizeDualUremap();
+
+    // Les variables duales ne sont lues et écrites que par computeDualUremap :
+    // leur synchronisation se poursuit pendant les étapes primales qui suivent
+    VarSyncMng* vsync = m_acc_env->vsyncMng();
+    MeshVariableSynchronizerList dual_vars(vsync->bufAddrMng());
+    dual_vars.add(m_phi_dual_lagrange);
+    dual_vars.add(m_u_dual_lagrange);
+    auto dual_sync = vsync->beginSync(dual_vars);
     
     Integer idir(-1);
     m_cartesian_mesh = CartesianInterface::ICartesianMesh::getReference(mesh());
@@ -47,10 +54,12 @@ void RemapADIService::appliRemap(Integer dimension, Integer withDualProjection,
       synchronizeUremap();
       
       if (withDualProjection) {
+        vsync->endSync(dual_sync);
         computeDualUremap(idir, nb_env);
-        synchronizeDualUremap();
+        dual_sync = vsync->beginSync(dual_vars);
       }
     }
+    vsync->endSync(dual_sync);
     m_sens_projection = m_sens_projection()+1;
     m_sens_projection = m_sens_projection()%(mesh()->dimension());
     
@@ -265,8 +274,12 @@ void RemapADIService::computeGradPhiFace(Integer idir, Integer nb_vars_to_projec
   } 
   queue_dfac.barrier(); // fin calcul m_is_dir_face
 #endif
-  m_grad_phi_face.synchronize();
-  m_h_cell_lagrange.synchronize();
+  {
+    MeshVariableSynchronizerList mvsl(m_acc_env->vsyncMng()->bufAddrMng());
+    mvsl.add(m_grad_phi_face);
+    mvsl.add(m_h_cell_lagrange);
+    m_acc_env->vsyncMng()->globalSynchronize(mvsl);
+  }
   PROF_ACC_END;
 }
 /**
@@ -1049,11 +1062,14 @@ void RemapADIService::computeUremap_PBorn0(Integer idir, Integer nb_vars_to_proj
  */
 void RemapADIService::synchronizeUremap()  {
     debug() << " Entree dans synchronizeUremap()";
-    m_phi_lagrange.synchronize();
-    m_u_lagrange.synchronize();
-    m_est_mixte.synchronize();
-    m_est_pure.synchronize();
-    m_dual_phi_flux.synchronize();
+    // Un seul message par voisin pour toutes les variables
+    MeshVariableSynchronizerList mvsl(m_acc_env->vsyncMng()->bufAddrMng());
+    mvsl.add(m_phi_lagrange);
+    mvsl.add(m_u_lagrange);
+    mvsl.add(m_est_mixte);
+    mvsl.add(m_est_pure);
+    mvsl.add(m_dual_phi_flux);
+    m_acc_env->vsyncMng()->globalSynchronize(mvsl);
 }
 /*---------------------------------------------------------------------------*/
 ARCANE_REGISTER_SERVICE_REMAPADI(RemapADI, RemapADIService);
@@ -300,19 +300,29 @@ class MultiEnvCellViewIn {
 /*---------------------------------------------------------------------------*/
 /* Stockage du multi-env                                                     */
 /*---------------------------------------------------------------------------*/
+/*!
+ * Les listes mixedCells() et pureCells() ne sont pas mises à jour
+ * incrémentalement : elles sont reconstruites entièrement (balayage de
+ * toutes les mailles sur l'hôte) à chaque buildStorage(), donc à chaque
+ * changement des environnements.
+ */
 class MultiEnvCellStorage {
  public:
   MultiEnvCellStorage(IMeshMaterialMng* mm, AccMemAdviser* acc_mem_adv) :
     m_mesh_material_mng (mm),
+    m_acc_mem_adv (acc_mem_adv),
     m_max_nb_env (mm->environments().size()),
     m_nb_env(VariableBuildInfo(mm->mesh(), "NbEnv" , IVariable::PNoDump| IVariable::PNoNeedSync)),
     m_l_env_arrays_idx(platform::getAcceleratorHostMemoryAllocator()),
     m_l_env_values_idx(VariableBuildInfo(mm->mesh(), "LEnvValuesIdx" , IVariable::PNoDump| IVariable::PNoNeedSync)),
-    m_env_id(VariableBuildInfo(mm->mesh(), "EnvId" , IVariable::PNoDump| IVariable::PNoNeedSync))
+    m_env_id(VariableBuildInfo(mm->mesh(), "EnvId" , IVariable::PNoDump| IVariable::PNoNeedSync)),
+    m_mixed_cells(platform::getAcceleratorHostMemoryAllocator()),
+    m_pure_cells(platform::getAcceleratorHostMemoryAllocator())
   {
     m_l_env_arrays_idx.resize(m_max_nb_env*mm->mesh()->allCells().size());
     acc_mem_adv->setReadMostly(m_l_env_arrays_idx.view());
     m_l_env_values_idx.resize(m_max_nb_env);
+    m_pure_cells_idx.resize(m_max_nb_env+1);
   }
 
   //! Remplissage
@@ -394,6 +404,8 @@ class MultiEnvCellStorage {
       }
     }
 
+    _buildCellLists();
+
     checkStorage(v_global_cell);
     PROF_ACC_END;
   }
@@ -432,13 +444,56 @@ class MultiEnvCellStorage {
     return MultiEnvCellViewIn(command, m_max_nb_env, m_nb_env, m_l_env_arrays_idx, m_l_env_values_idx, m_env_id);
   }
 
+  //! Ids locaux des mailles mixtes ou vides (m_env_id<0), utilisable sur GPU
+  Span<const Int32> mixedCells() const {
+    return m_mixed_cells.constSpan();
+  }
+
+  //! Ids locaux des mailles pures de l'environnement env_id, utilisable sur GPU
+  Span<const Int32> pureCells(Integer env_id) const {
+    return m_pure_cells.constSpan().subspan(m_pure_cells_idx[env_id], 
+        m_pure_cells_idx[env_id+1]-m_pure_cells_idx[env_id]);
+  }
+
+ protected:
+
+  //! Listes compactes des mailles mixtes et des mailles pures par environnement,
+  //! reconstruites entièrement (pas de mise à jour incrémentale)
+  void _buildCellLists() {
+    // m_env_id a été calculé sur l'hôte
+    m_mixed_cells.clear();
+    ENUMERATE_CELL(icell, m_mesh_material_mng->mesh()->allCells()){
+      if (m_env_id[icell]<0) {
+        m_mixed_cells.add(icell.localId());
+      }
+    }
+
+    // Pour les mailles pures, valueIndexes() est la liste des ids locaux des mailles
+    m_pure_cells.clear();
+    m_pure_cells_idx[0] = 0;
+    ENUMERATE_ENV(ienv, m_mesh_material_mng) {
+      IMeshEnvironment* env = *ienv;
+      Integer env_id = env->id();
+      m_pure_cells.addRange(env->pureEnvItems().valueIndexes());
+      m_pure_cells_idx[env_id+1] = m_pure_cells.size();
+    }
+
+    // Les tableaux ont pu être réalloués
+    m_acc_mem_adv->setReadMostly(m_mixed_cells.view());
+    m_acc_mem_adv->setReadMostly(m_pure_cells.view());
+  }
+
  protected:
   IMeshMaterialMng* m_mesh_material_mng=nullptr;
+  AccMemAdviser* m_acc_mem_adv=nullptr;
   Integer m_max_nb_env;
   VariableCellInteger m_nb_env;  //! Nb d'env par maille
   UniqueArray<Int16> m_l_env_arrays_idx; //! liste des indexes des env par maille
   VariableCellArrayInteger m_l_env_values_idx;
   VariableCellInteger m_env_id;
+  UniqueArray<Int32> m_mixed_cells;  //! mailles mixtes ou vides
+  UniqueArray<Int32> m_pure_cells;  //! mailles pures, rangées environnement par environnement
+  IntegerUniqueArray m_pure_cells_idx;  //! début des mailles pures de chaque env dans m_pure_cells
 };
 
 #endif
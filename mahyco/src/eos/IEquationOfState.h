@@ -22,6 +22,7 @@
 #include "arcane/materials/MeshMaterialIndirectModifier.h"
 #include "arcane/materials/MeshMaterialVariableSynchronizerList.h"
 #include "arcane/materials/ComponentSimd.h"
+#include "accenv/AcceleratorUtils.h"
 
 using namespace Arcane;
 using namespace Arcane::Materials;
@@ -48,11 +49,32 @@ public:
    *  et calcule la vitesse du son et la pression. 
    */
   virtual void applyEOS(IMeshEnvironment* env) = 0;
+  /** 
+   *  Lance l'équation d'état sur les mailles pures et mixtes de l'environnement
+   *  sur la queue passée en argument, sans attendre la fin des calculs.
+   *  L'appelant doit faire queue.barrier() avant d'utiliser les résultats.
+   */
+  virtual void asyncApplyEOS(IMeshEnvironment* env, ax::RunQueue& queue) = 0;
+  /**
+   *  Applique l'équation d'état sur les mailles pures et mixtes de
+   *  l'environnement par de simples boucles sur l'hôte, sans RunQueue :
+   *  peut être appelée depuis une tâche.
+   */
+  virtual void hostApplyEOS(IMeshEnvironment* env) = 0;
     /** 
    *  Applique l'équation d'état au groupe de mailles passé en argument
    *  et calcule la vitesse du son et la pression pour une cellule
    */
   virtual void applyOneCellEOS(IMeshEnvironment* env, EnvCell ev) = 0;
+  /** 
+   *  Applique l'équation d'état à un lot de valeurs de l'environnement
+   *  (densité, énergie interne) en mémoire hôte et calcule la pression,
+   *  la vitesse du son et dp/de, sans passer par les variables matériaux.
+   *  Tous les tableaux ont la même taille.
+   */
+  virtual void applyEOSValues(IMeshEnvironment* env,
+      Span<const Real> density, Span<const Real> internal_energy,
+      Span<Real> pressure, Span<Real> sound_speed, Span<Real> dpde) = 0;
   /** 
    *  Renvoie la constante adiabatic de l'environnement. 
    */
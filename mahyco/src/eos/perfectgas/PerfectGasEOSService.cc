@@ -49,9 +49,9 @@ ARCCORE_HOST_DEVICE inline void compute_pressure_sndspd_PG(Real adiabatic_cst,
 
 void PerfectGasEOSService::applyEOS(IMeshEnvironment* env)
 {
-  Real adiabatic_cst = getAdiabaticCst(env);
   // Calcul de la pression et de la vitesse du son
 #if 0
+  Real adiabatic_cst = getAdiabaticCst(env);
   ENUMERATE_ENVCELL(ienvcell,env)
   {
     EnvCell ev = *ienvcell;
@@ -61,6 +61,7 @@ void PerfectGasEOSService::applyEOS(IMeshEnvironment* env)
         m_pressure[ev], m_sound_speed[ev], m_dpde[ev]);
   }
 #elif 0
+  Real adiabatic_cst = getAdiabaticCst(env);
   Parallel::Foreach(env->envView(),[&](EnvItemVectorView view)
   {
     ENUMERATE_ENVCELL(ienvcell,view){
@@ -70,11 +71,21 @@ void PerfectGasEOSService::applyEOS(IMeshEnvironment* env)
     }
   });
 #else
+  auto queue = m_acc_env->newQueue();
+  queue.setAsync(true);
+  asyncApplyEOS(env, queue);
+  queue.barrier();
+#endif
+}
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void PerfectGasEOSService::asyncApplyEOS(IMeshEnvironment* env, ax::RunQueue& queue)
+{
+  Real adiabatic_cst = getAdiabaticCst(env);
   // Mailles pures
-  auto queue_pur = m_acc_env->newQueue();
-  queue_pur.setAsync(true);
   {
-    auto command = makeCommand(queue_pur);
+    auto command = makeCommand(queue);
 
     // Nombre de mailles pures de l'environnement
     Integer nb_pur = env->pureEnvItems().nbItem();
@@ -106,11 +117,9 @@ void PerfectGasEOSService::applyEOS(IMeshEnvironment* env)
     }; // non-bloquant et asynchrone par rapport au CPU et autres queues
   }
 
-  // Mailles mixtes
-  auto queue_mix = m_acc_env->newQueue();
-  queue_mix.setAsync(true);
+  // Mailles mixtes, sur la même queue à la suite des mailles pures
   {
-    auto command = makeCommand(queue_mix);
+    auto command = makeCommand(queue);
 
     // Nombre de mailles impures (mixtes) de l'environnement
     Integer nb_imp = env->impureEnvItems().nbItem();
@@ -131,9 +140,44 @@ void PerfectGasEOSService::applyEOS(IMeshEnvironment* env)
 
     }; // non-bloquant et asynchrone par rapport au CPU et autres queues
   }
-  queue_pur.barrier();
-  queue_mix.barrier();
-#endif
+}
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void PerfectGasEOSService::hostApplyEOS(IMeshEnvironment* env)
+{
+  Real adiabatic_cst = getAdiabaticCst(env);
+  // Mailles pures : accès indirect aux valeurs des variables globales
+  {
+    Span<const Int32> in_cell_id(env->pureEnvItems().valueIndexes());
+
+    Span<const Real> in_density         (m_density.globalVariable().asArray());
+    Span<const Real> in_internal_energy (m_internal_energy.globalVariable().asArray());
+
+    Span<Real> out_pressure    (m_pressure.globalVariable().asArray());
+    Span<Real> out_sound_speed (m_sound_speed.globalVariable().asArray());
+    Span<Real> out_dpde        (m_dpde.globalVariable().asArray());
+
+    for (Int64 ipur = 0; ipur < in_cell_id.size(); ++ipur) {
+      Int32 cid = in_cell_id[ipur];
+      compute_pressure_sndspd_PG(adiabatic_cst,
+          in_density[cid], in_internal_energy[cid],
+          out_pressure[cid], out_sound_speed[cid], out_dpde[cid]);
+    }
+  }
+
+  // Mailles mixtes : valeurs contiguës de l'environnement
+  {
+    Span<const Real> in_density         (envView(m_density, env));
+    Span<const Real> in_internal_energy (envView(m_internal_energy, env));
+
+    Span<Real> out_pressure    (envView(m_pressure, env));
+    Span<Real> out_sound_speed (envView(m_sound_speed, env));
+    Span<Real> out_dpde        (envView(m_dpde, env));
+
+    applyEOSValues(env, in_density, in_internal_energy,
+        out_pressure, out_sound_speed, out_dpde);
+  }
 }
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -159,6 +203,22 @@ void PerfectGasEOSService::applyOneCellEOS(IMeshEnvironment* env, EnvCell ev)
 }
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
+
+void PerfectGasEOSService::applyEOSValues(IMeshEnvironment* env,
+    Span<const Real> density, Span<const Real> internal_energy,
+    Span<Real> pressure, Span<Real> sound_speed, Span<Real> dpde)
+{
+  Real adiabatic_cst = getAdiabaticCst(env);
+  // Boucle sans dépendance entre les itérations (vectorisable)
+  Int64 nb_val = density.size();
+  for (Int64 i = 0; i < nb_val; ++i) {
+    compute_pressure_sndspd_PG(adiabatic_cst,
+        density[i], internal_energy[i],
+        pressure[i], sound_speed[i], dpde[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
 Real PerfectGasEOSService::getAdiabaticCst(IMeshEnvironment* env) { return options()->adiabaticCst();}
 Real PerfectGasEOSService::getTensionLimitCst(IMeshEnvironment* env) { return options()->limitTension();}
 /*---------------------------------------------------------------------------*/
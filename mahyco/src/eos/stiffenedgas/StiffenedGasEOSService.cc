@@ -22,6 +22,19 @@ void StiffenedGasEOSService::initEOS(IMeshEnvironment* env)
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/* Formule StiffenedGas pour calculer unitairement pression, vitesse du son  */
+/* et dp/de, appelée dans asyncApplyEOS(...) et applyEOSValues(...)          */
+/*---------------------------------------------------------------------------*/
+ARCCORE_HOST_DEVICE inline void compute_pressure_sndspd_SG(Real adiabatic_cst,
+    Real limit_tension, Real density, Real internal_energy,
+    Real& pressure, Real& sound_speed, Real& dpde) 
+{
+  pressure = ((adiabatic_cst - 1.) * density * internal_energy) - (adiabatic_cst * limit_tension);
+  sound_speed = sqrt((adiabatic_cst/density)*(pressure+limit_tension));
+  dpde = (adiabatic_cst - 1.) * density;
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -44,6 +57,108 @@ void StiffenedGasEOSService::applyEOS(IMeshEnvironment* env)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void StiffenedGasEOSService::asyncApplyEOS(IMeshEnvironment* env, ax::RunQueue& queue)
+{
+  Real limit_tension = getTensionLimitCst(env);
+  Real adiabatic_cst = getAdiabaticCst(env);
+  // Mailles pures
+  {
+    auto command = makeCommand(queue);
+
+    // Nombre de mailles pures de l'environnement
+    Integer nb_pur = env->pureEnvItems().nbItem();
+
+    // Pour les mailles pures, valueIndexes() est la liste des ids locaux des mailles
+    Span<const Int32> in_cell_id(env->pureEnvItems().valueIndexes());
+
+    auto in_density         = ax::viewIn(command, m_density.globalVariable());
+    auto in_internal_energy = ax::viewIn(command, m_internal_energy.globalVariable());
+
+    auto out_pressure    = ax::viewOut(command, m_pressure.globalVariable());
+    auto out_sound_speed = ax::viewOut(command, m_sound_speed.globalVariable());
+    auto out_dpde        = ax::viewOut(command, m_dpde.globalVariable());
+
+    command << RUNCOMMAND_LOOP1(iter, nb_pur) {
+      auto [ipur] = iter(); // ipur \in [0,nb_pur[
+      CellLocalId cid(in_cell_id[ipur]); // accés indirect à la valeur de la maille
+
+      Real pressure, sound_speed, dpde;
+
+      compute_pressure_sndspd_SG(adiabatic_cst, limit_tension,
+          in_density[cid], in_internal_energy[cid],
+          pressure, sound_speed, dpde);
+
+      out_pressure[cid] = pressure;
+      out_sound_speed[cid] = sound_speed;
+      out_dpde[cid] = dpde;
+    }; // non-bloquant
+  }
+
+  // Mailles mixtes, sur la même queue à la suite des mailles pures
+  {
+    auto command = makeCommand(queue);
+
+    // Nombre de mailles impures (mixtes) de l'environnement
+    Integer nb_imp = env->impureEnvItems().nbItem();
+
+    Span<const Real> in_density         (envView(m_density, env));
+    Span<const Real> in_internal_energy (envView(m_internal_energy, env));
+
+    Span<Real> out_pressure    (envView(m_pressure, env));
+    Span<Real> out_sound_speed (envView(m_sound_speed, env));
+    Span<Real> out_dpde        (envView(m_dpde, env));
+
+    command << RUNCOMMAND_LOOP1(iter, nb_imp) {
+      auto [imix] = iter(); // imix \in [0,nb_imp[
+
+      compute_pressure_sndspd_SG(adiabatic_cst, limit_tension,
+          in_density[imix], in_internal_energy[imix],
+          out_pressure[imix], out_sound_speed[imix], out_dpde[imix]);
+    }; // non-bloquant
+  }
+}
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void StiffenedGasEOSService::hostApplyEOS(IMeshEnvironment* env)
+{
+  Real limit_tension = getTensionLimitCst(env);
+  Real adiabatic_cst = getAdiabaticCst(env);
+  // Mailles pures : accès indirect aux valeurs des variables globales
+  {
+    Span<const Int32> in_cell_id(env->pureEnvItems().valueIndexes());
+
+    Span<const Real> in_density         (m_density.globalVariable().asArray());
+    Span<const Real> in_internal_energy (m_internal_energy.globalVariable().asArray());
+
+    Span<Real> out_pressure    (m_pressure.globalVariable().asArray());
+    Span<Real> out_sound_speed (m_sound_speed.globalVariable().asArray());
+    Span<Real> out_dpde        (m_dpde.globalVariable().asArray());
+
+    for (Int64 ipur = 0; ipur < in_cell_id.size(); ++ipur) {
+      Int32 cid = in_cell_id[ipur];
+      compute_pressure_sndspd_SG(adiabatic_cst, limit_tension,
+          in_density[cid], in_internal_energy[cid],
+          out_pressure[cid], out_sound_speed[cid], out_dpde[cid]);
+    }
+  }
+
+  // Mailles mixtes : valeurs contiguës de l'environnement
+  {
+    Span<const Real> in_density         (envView(m_density, env));
+    Span<const Real> in_internal_energy (envView(m_internal_energy, env));
+
+    Span<Real> out_pressure    (envView(m_pressure, env));
+    Span<Real> out_sound_speed (envView(m_sound_speed, env));
+    Span<Real> out_dpde        (envView(m_dpde, env));
+
+    applyEOSValues(env, in_density, in_internal_energy,
+        out_pressure, out_sound_speed, out_dpde);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void StiffenedGasEOSService::applyOneCellEOS(IMeshEnvironment* env, EnvCell ev)
 {
   // Calcul de la pression et de la vitesse du son
@@ -58,6 +173,24 @@ void StiffenedGasEOSService::applyOneCellEOS(IMeshEnvironment* env, EnvCell ev)
 }
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
+
+void StiffenedGasEOSService::applyEOSValues(IMeshEnvironment* env,
+    Span<const Real> density, Span<const Real> internal_energy,
+    Span<Real> pressure, Span<Real> sound_speed, Span<Real> dpde)
+{
+  // Calcul de la pression et de la vitesse du son
+  Real limit_tension = getTensionLimitCst(env);
+  Real adiabatic_cst = getAdiabaticCst(env);
+  // Boucle sans dépendance entre les itérations (vectorisable)
+  Int64 nb_val = density.size();
+  for (Int64 i = 0; i < nb_val; ++i) {
+    compute_pressure_sndspd_SG(adiabatic_cst, limit_tension,
+        density[i], internal_energy[i],
+        pressure[i], sound_speed[i], dpde[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
 Real StiffenedGasEOSService::getAdiabaticCst(IMeshEnvironment* env) { return options()->adiabaticCst();}
 Real StiffenedGasEOSService::getTensionLimitCst(IMeshEnvironment* env) { return options()->limitTension();}
 /*---------------------------------------------------------------------------*/
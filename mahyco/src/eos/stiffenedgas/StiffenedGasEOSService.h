@@ -22,6 +22,7 @@
 #include "arcane/materials/MeshMaterialIndirectModifier.h"
 #include "arcane/materials/MeshMaterialVariableSynchronizerList.h"
 #include "arcane/materials/ComponentSimd.h"
+#include "accenv/MultiEnvUtils.h"
 
 using namespace Arcane;
 using namespace Arcane::Materials;
@@ -51,11 +52,26 @@ class StiffenedGasEOSService
    *  et calcule la vitesse du son et la pression. 
    */
   virtual void applyEOS(IMeshEnvironment* env);
+  /** 
+   *  Lance l'équation d'état sur la queue passée en argument (asynchrone)
+   */
+  virtual void asyncApplyEOS(IMeshEnvironment* env, ax::RunQueue& queue);
+  /**
+   *  Applique l'équation d'état sur l'hôte, sans RunQueue
+   */
+  virtual void hostApplyEOS(IMeshEnvironment* env);
    /** 
    *  Applique l'équation d'état au groupe de mailles passé en argument
    *  et calcule la vitesse du son et la pression pour une cellule
    */
   virtual void applyOneCellEOS(IMeshEnvironment* env, EnvCell ev);
+  /** 
+   *  Applique l'équation d'état à un lot de valeurs de l'environnement
+   *  et calcule la vitesse du son, la pression et dp/de
+   */
+  virtual void applyEOSValues(IMeshEnvironment* env,
+      Span<const Real> density, Span<const Real> internal_energy,
+      Span<Real> pressure, Span<Real> sound_speed, Span<Real> dpde);
   /** 
    *  Renvoie la constante adiabatic de l'environnement. 
    */
@@ -0,0 +1,139 @@
+#include "msgpass/Algo1SyncDataGlobal.h"
+
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/* \class Algo1SyncDataGlobal                                                */
+/* \brief Implementation of IAlgo1SyncData for a list of global variables    */
+/*   (possibly on different item kinds) aggregated in one message per       */
+/*   neighbour                                                               */
+/*   packing/unpacking on Host                                               */
+/*   communicating (MPI) on Host                                             */
+/*---------------------------------------------------------------------------*/
+
+Algo1SyncDataGlobal::Algo1SyncDataGlobal(
+    MeshVariableSynchronizerList& vars,
+    ConstArrayView<ConstMultiArray2View<Integer>> owned_item_idx_pv,
+    ConstArrayView<ConstMultiArray2View<Integer>> ghost_item_idx_pv,
+    SyncBuffers* sync_buffers
+    ) :
+  m_vars              (vars),
+  m_owned_item_idx_pv (owned_item_idx_pv),
+  m_ghost_item_idx_pv (ghost_item_idx_pv),
+  m_sync_buffers      (sync_buffers)
+{
+}
+
+Algo1SyncDataGlobal::~Algo1SyncDataGlobal() {
+}
+
+/*---------------------------------------------------------------------------*/
+/* True if there is no data to synchronize                                   */
+/*---------------------------------------------------------------------------*/
+bool Algo1SyncDataGlobal::isEmpty() {
+  return m_vars.globalVarsList().size()==0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Initialization step before beginning communications                       */
+/*---------------------------------------------------------------------------*/
+void Algo1SyncDataGlobal::initComm() {
+
+  auto lvars = m_vars.globalVarsList();
+  Integer nb_var = lvars.size();
+
+  UniqueArray<IMeshVarSync::SizeInfos> size_infos_pv(nb_var);
+  UniqueArray<IntegerConstArrayView> nb_owned_item_pv(nb_var);
+  UniqueArray<IntegerConstArrayView> nb_ghost_item_pv(nb_var);
+
+  // On prévoit une taille max du buffer qui va contenir tous les messages
+  Int64 buf_estim_sz=0;
+  size_t max_align=1;
+  for(Integer ivar=0 ; ivar<nb_var ; ++ivar) {
+    size_infos_pv[ivar] = lvars[ivar]->sizeInfos();
+    nb_owned_item_pv[ivar] = m_owned_item_idx_pv[ivar].dim2Sizes();
+    nb_ghost_item_pv[ivar] = m_ghost_item_idx_pv[ivar].dim2Sizes();
+
+    buf_estim_sz += lvars[ivar]->estimatedMaxBufSz(nb_owned_item_pv[ivar]);
+    buf_estim_sz += lvars[ivar]->estimatedMaxBufSz(nb_ghost_item_pv[ivar]);
+    max_align = std::max(max_align, size_infos_pv[ivar].alignOf);
+  }
+  // Le début du bloc de chaque voisin est aligné sur max_align (envoi + réception)
+  Integer nb_nei = (nb_var>0 ? nb_owned_item_pv[0].size() : 0);
+  buf_estim_sz += 2*nb_nei*max_align;
+
+  m_sync_buffers->resetBuf();
+  // Le buffer de tous les messages est réalloué si pas assez de place
+  m_sync_buffers->allocIfNeeded(buf_estim_sz);
+
+  // On récupère les adresses et tailles des buffers d'envoi et de réception 
+  // sur l'HOTE (_h et "0")
+  m_buf_snd_h = m_sync_buffers->multiBufViewVars(size_infos_pv, nb_owned_item_pv, 0);
+  m_buf_rcv_h = m_sync_buffers->multiBufViewVars(size_infos_pv, nb_ghost_item_pv, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Get the receive buffer for the neighbour inei                             */
+/*---------------------------------------------------------------------------*/
+ArrayView<Byte> Algo1SyncDataGlobal::recvBuf(Integer inei) {
+  return m_buf_rcv_h.multiView(inei).rangeView();
+}
+
+/*---------------------------------------------------------------------------*/
+/* Get the send buffer for the neighbour inei                                */
+/*---------------------------------------------------------------------------*/
+ArrayView<Byte> Algo1SyncDataGlobal::sendBuf(Integer inei) {
+  return m_buf_snd_h.multiView(inei).rangeView();
+}
+
+/*---------------------------------------------------------------------------*/
+/* Prepare the sendings for every neighbour                                  */
+/*---------------------------------------------------------------------------*/
+void Algo1SyncDataGlobal::initSendings() {
+  // Le packing est fait voisin par voisin dans finalizePackBeforeSend
+}
+
+/*---------------------------------------------------------------------------*/
+/* Prepare the sending for one neighbour                                     */
+/*---------------------------------------------------------------------------*/
+void Algo1SyncDataGlobal::finalizePackBeforeSend(Integer inei) {
+
+  auto lvars = m_vars.globalVarsList();
+  Integer nb_var = lvars.size();
+
+  auto byte_buf_snd_h = m_buf_snd_h.multiView(inei); // le buffer d'envoi pour inei sur l'HOTE
+
+  // "buf_snd[inei] <= var" pour toutes les variables
+  for(Integer ivar=0 ; ivar<nb_var ; ++ivar) {
+    lvars[ivar]->packIntoBuf(m_owned_item_idx_pv[ivar][inei], byte_buf_snd_h.byteBuf(ivar));
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Finalize the sendings for every neighbour                                 */
+/*---------------------------------------------------------------------------*/
+void Algo1SyncDataGlobal::finalizeSendings() {
+}
+
+/*---------------------------------------------------------------------------*/
+/* Data treatement after receiving the message from the neighbour inei       */
+/*---------------------------------------------------------------------------*/
+void Algo1SyncDataGlobal::unpackAfterRecv(Integer inei) {
+
+  auto lvars = m_vars.globalVarsList();
+  Integer nb_var = lvars.size();
+
+  auto byte_buf_rcv_h = m_buf_rcv_h.multiView(inei); // buffer des données reçues sur l'HOTE
+
+  // "var <= buf_rcv[inei]" pour toutes les variables
+  for(Integer ivar=0 ; ivar<nb_var ; ++ivar) {
+    lvars[ivar]->unpackFromBuf(m_ghost_item_idx_pv[ivar][inei], byte_buf_rcv_h.byteBuf(ivar));
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Finalize the receipts for every neighbour                                 */
+/*---------------------------------------------------------------------------*/
+void Algo1SyncDataGlobal::finalizeReceipts() {
+}
+
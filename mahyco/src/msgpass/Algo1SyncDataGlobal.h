@@ -0,0 +1,67 @@
+#ifndef MSG_PASS_ALGO1_SYNC_DATA_GLOBAL_H
+#define MSG_PASS_ALGO1_SYNC_DATA_GLOBAL_H
+
+#include "msgpass/IAlgo1SyncData.h"
+#include "msgpass/MeshVariableSynchronizerList.h"
+#include "msgpass/SyncBuffers.h"
+
+/*---------------------------------------------------------------------------*/
+/* \class Algo1SyncDataGlobal                                                */
+/* \brief Implementation of IAlgo1SyncData for a list of global variables    */
+/*   (possibly on different item kinds) aggregated in one message per       */
+/*   neighbour                                                               */
+/*   packing/unpacking on Host                                               */
+/*   communicating (MPI) on Host                                             */
+/*---------------------------------------------------------------------------*/
+class Algo1SyncDataGlobal : public IAlgo1SyncData {
+ public:
+  /*!
+   * \brief owned_item_idx_pv[ivar] and ghost_item_idx_pv[ivar] are the
+   * items per neighbour to send/receive for the ivar-th global variable
+   */
+  Algo1SyncDataGlobal(MeshVariableSynchronizerList& vars,
+      ConstArrayView<ConstMultiArray2View<Integer>> owned_item_idx_pv,
+      ConstArrayView<ConstMultiArray2View<Integer>> ghost_item_idx_pv,
+      SyncBuffers* sync_buffers);
+
+  virtual ~Algo1SyncDataGlobal();
+
+  //! True if there is no data to synchronize
+  bool isEmpty() override;
+
+  //! Initialization step before beginning communications
+  void initComm() override;
+
+  //! Get the receive buffer for the neighbour inei
+  ArrayView<Byte> recvBuf(Integer inei) override;
+
+  //! Get the send buffer for the neighbour inei
+  ArrayView<Byte> sendBuf(Integer inei) override;
+
+  //! Prepare the sendings for every neighbour
+  void initSendings() override;
+
+  //! Prepare the sending for one neighbour
+  void finalizePackBeforeSend(Integer inei) override;
+
+  //! Finalize the sendings for every neighbour
+  void finalizeSendings() override;
+
+  //! Data treatement after receiving the message from the neighbour inei
+  void unpackAfterRecv(Integer inei) override;
+
+  //! Finalize the receipts for every neighbour
+  void finalizeReceipts() override;
+
+ protected:
+  MeshVariableSynchronizerList& m_vars;
+  ConstArrayView<ConstMultiArray2View<Integer>> m_owned_item_idx_pv;  //! Per variable, owned items per neighbour
+  ConstArrayView<ConstMultiArray2View<Integer>> m_ghost_item_idx_pv;  //! Per variable, ghost items per neighbour
+  SyncBuffers* m_sync_buffers=nullptr;
+
+  MultiBufView2 m_buf_snd_h;  //! Buffers on Host (_h) to send
+  MultiBufView2 m_buf_rcv_h;  //! Buffers on Host (_h) to recv
+};
+
+#endif
+
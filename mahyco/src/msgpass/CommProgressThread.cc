@@ -0,0 +1,86 @@
+#include "msgpass/CommProgressThread.h"
+
+#include <arcane/utils/ArcaneGlobal.h>
+
+/*---------------------------------------------------------------------------*/
+/* CommProgressThread                                                        */
+/*---------------------------------------------------------------------------*/
+CommProgressThread::CommProgressThread() :
+  m_thread (&CommProgressThread::_run, this)
+{
+}
+
+CommProgressThread::~CommProgressThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+/*---------------------------------------------------------------------------*/
+/* Run task on the progression thread, returns immediately                   */
+/*---------------------------------------------------------------------------*/
+void CommProgressThread::post(std::function<void()> task)
+{
+  ARCANE_ASSERT(!m_is_pending, ("A task is already posted on the progression thread"));
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = std::move(task);
+    m_is_done = false;
+    m_exception = nullptr;
+  }
+  m_is_pending = true;
+  m_cv.notify_all();
+}
+
+/*---------------------------------------------------------------------------*/
+/* Wait for the end of the posted task, rethrows its exception if any        */
+/*---------------------------------------------------------------------------*/
+void CommProgressThread::wait()
+{
+  if (!m_is_pending) {
+    return;
+  }
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_is_done; });
+    exception = m_exception;
+    m_exception = nullptr;
+  }
+  m_is_pending = false;
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Loop executed by m_thread                                                 */
+/*---------------------------------------------------------------------------*/
+void CommProgressThread::_run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this]() { return m_stop || m_task; });
+    if (m_task) {
+      std::function<void()> task;
+      task.swap(m_task);
+      lock.unlock();
+      std::exception_ptr exception;
+      try {
+        task();
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      lock.lock();
+      m_exception = exception;
+      m_is_done = true;
+      m_cv.notify_all();
+    } else if (m_stop) {
+      break;
+    }
+  }
+}
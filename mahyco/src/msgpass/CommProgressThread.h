@@ -0,0 +1,47 @@
+#ifndef MSG_PASS_COMM_PROGRESS_THREAD_H
+#define MSG_PASS_COMM_PROGRESS_THREAD_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/* \class CommProgressThread                                                 */
+/* \brief Host thread dedicated to communications                            */
+/*   A task (packing, MPI exchanges, unpacking) is posted to the thread and  */
+/*   runs while the calling thread goes on computing with the task pool.     */
+/*   The thread is created once and lives as long as the instance.           */
+/*   Only one task at a time.                                                */
+/*---------------------------------------------------------------------------*/
+class CommProgressThread {
+ public:
+  CommProgressThread();
+  virtual ~CommProgressThread();
+
+  //! Run task on the progression thread, returns immediately
+  void post(std::function<void()> task);
+
+  //! Wait for the end of the posted task, rethrows its exception if any
+  void wait();
+
+  //! True if a posted task has not been waited for yet
+  bool isPending() const { return m_is_pending; }
+
+ protected:
+  //! Loop executed by m_thread
+  void _run();
+
+ protected:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::function<void()> m_task;  //! Task to execute, empty if none
+  std::exception_ptr m_exception;  //! Exception thrown by the last task
+  bool m_is_pending=false;  //! True between post() and wait()
+  bool m_is_done=false;  //! True when the posted task is over
+  bool m_stop=false;  //! Asks m_thread to finish
+  std::thread m_thread;  //! Created last, once the other members are initialized
+};
+
+#endif
@@ -111,6 +111,37 @@ computeAndSync(Func func, MeshVariableRefT var, eVarSyncVersion vs_version) {
     // On attend la terminaison des calculs intérieurs
     ref_queue_inr->barrier();
   } 
+  else if (vs_version == VS_overlap_thread) 
+  {
+    SyncItems<ItemType>* sync_items = this->getSyncItems<ItemType>();
+
+    // Le calcul sur les items "own" du bord du sous-domaine doit être
+    // terminé avant le packing sur l'hôte
+    auto ref_queue = AcceleratorUtils::refQueueAsync(m_runner, QP_default); 
+    func(sync_items->sharedItems(), ref_queue.get());
+    ref_queue->barrier();
+
+    MeshVariableSynchronizerList vars(m_buf_addr_mng);
+    vars.add(var);
+
+    if (isCommThreadAvailable()) {
+      tm->debug() << "overlap_thread";
+      // Le thread de progression effectue packing, comms MPI et unpacking
+      // pendant que le pool de tâches calcule les items intérieurs
+      ThreadSyncGuard thr_sync(this, vars);
+      func(sync_items->privateItems(), ref_queue.get());
+      ref_queue->barrier();
+      thr_sync.wait();
+    } else {
+      // Pas de MPI_THREAD_MULTIPLE ou de requêtes persistantes : les comms sont amorcées puis
+      // terminées par le thread appelant, de part et d'autre du calcul intérieur
+      tm->debug() << "overlap_thread (beginSync/endSync)";
+      auto ref_req = this->beginSync(vars);
+      func(sync_items->privateItems(), ref_queue.get());
+      ref_queue->barrier();
+      this->endSync(ref_req);
+    }
+  } 
   else
   {
     ARCANE_ASSERT(vs_version==VS_nosync,
@@ -184,9 +184,10 @@ computeMatAndSyncOnEvents(ArrayView<Ref<ax::RunQueueEvent>> depends_on_evts,
     // On attend la terminaison des calculs intérieurs
     ref_queue_inr->barrier();
   } 
-  else if (vs_version == VS_overlap_iqueue) 
+  else if (vs_version == VS_overlap_iqueue ||
+      vs_version == VS_overlap_thread) 
   {
-    tm->debug() << "overlap_iqueue";
+    tm->debug() << "overlap_iqueue|overlap_thread";
     throw NotSupportedException(A_FUNCINFO,
         String::format("Invalid eVarSyncVersion={0}",(int)vs_version));
   } 
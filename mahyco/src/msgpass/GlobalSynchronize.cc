@@ -1,119 +1,11 @@
 #include "msgpass/VarSyncMng.h"
+#include "msgpass/PackTransfer.h"
 
 #include <arcane/IParallelMng.h>
 #include <arcane/MeshVariableScalarRef.h>
 #include <arcane/MeshVariableArrayRef.h>
 #include <arcane/VariableBuildInfo.h>
 
-/*---------------------------------------------------------------------------*/
-/* pack_var2buf */
-/*---------------------------------------------------------------------------*/
-template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
-void pack_var2buf(IntegerConstArrayView item_idx, 
-    const MeshVarRefT<ItemType, DataType>& var,
-    ArrayView<Byte> buf) 
-{
-  // Ne devrait jamais être appelé
-  ARCANE_ASSERT(false, ("pack_var2buf à spécifialiser"));
-}
-
-// Spécialisation pour MeshVariable***Scalar***RefT
-template<typename ItemType, typename DataType>
-void pack_var2buf(IntegerConstArrayView item_idx, 
-    const MeshVariableScalarRefT<ItemType, DataType>& var,
-    ArrayView<Byte> buf) 
-{
-  auto var_arr = var.asArray();
-
-  ArrayView<DataType> buf_vals(MultiBufView::valBuf<DataType>(buf));
-
-  Integer nb_item_idx = item_idx.size();
-
-  for(Integer i=0 ; i<nb_item_idx ; ++i) {
-    LocalIdType lid{item_idx[i]};
-    buf_vals[i] = var_arr[lid];
-  }
-}
-
-// Spécialisation pour MeshVariable***Array***RefT
-template<typename ItemType, typename DataType>
-void pack_var2buf(IntegerConstArrayView item_idx, 
-    const MeshVariableArrayRefT<ItemType, DataType>& var,
-    ArrayView<Byte> buf) 
-{
-  auto var_arr = var.asArray();
-
-  Integer degree = var.arraySize();
-  // Vue sur tableau 2D [nb_item][degree]
-  Array2View<DataType> buf_vals(MultiBufView::valBuf2<DataType>(buf, degree));
-
-  Integer nb_item_idx = item_idx.size();
-
-  for(Integer i=0 ; i<nb_item_idx ; ++i) {
-    LocalIdType lid{item_idx[i]};
-    Span<const DataType> in_var_arr  (var_arr[lid]);
-    Span<DataType>       out_buf_vals(buf_vals[i]);
-    for(Integer j=0 ; j<degree ; ++j) {
-      out_buf_vals[j] = in_var_arr[j];
-    }
-  }
-}
-
-/*---------------------------------------------------------------------------*/
-/* unpack_buf2var */
-/*---------------------------------------------------------------------------*/
-template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
-void unpack_buf2var(IntegerConstArrayView item_idx, 
-    ArrayView<Byte> buf,
-    MeshVarRefT<ItemType, DataType> &var) 
-{
-  // Ne devrait jamais être appelé
-  ARCANE_ASSERT(false, ("unpack_buf2var à spécifialiser"));
-}
-
-// Spécialisation pour MeshVariable***Scalar***RefT
-template<typename ItemType, typename DataType>
-void unpack_buf2var(IntegerConstArrayView item_idx, 
-    ArrayView<Byte> buf,
-    MeshVariableScalarRefT<ItemType, DataType> &var)
-{
-  auto var_arr = var.asArray();
-
-  ConstArrayView<DataType> buf_vals(MultiBufView::valBuf<DataType>(buf));
-
-  Integer nb_item_idx = item_idx.size();
-
-  for(Integer i=0 ; i<nb_item_idx ; ++i) {
-    LocalIdType lid{item_idx[i]};
-    var_arr[lid] = buf_vals[i];
-  }
-}
-
-// Spécialisation pour MeshVariable***Array***RefT
-template<typename ItemType, typename DataType>
-void unpack_buf2var(IntegerConstArrayView item_idx, 
-    ArrayView<Byte> buf,
-    MeshVariableArrayRefT<ItemType, DataType> &var)
-{
-  auto var_arr = var.asArray();
-
-  Integer degree = var.arraySize();
-  // Vue sur tableau 2D [nb_item][degree]
-  ConstArray2View<DataType> buf_vals(MultiBufView::valBuf2<DataType>(buf, degree));
-
-
-  Integer nb_item_idx = item_idx.size();
-
-  for(Integer i=0 ; i<nb_item_idx ; ++i) {
-    LocalIdType lid{item_idx[i]};
-    Span<const DataType> in_buf_vals(buf_vals[i]);
-    Span<DataType>       out_var_arr(var_arr[lid]);
-    for(Integer j=0 ; j<degree ; ++j) {
-      out_var_arr[j] = in_buf_vals[j];
-    }
-  }
-}
-
 /*---------------------------------------------------------------------------*/
 /* Equivalent à un var.synchronize() où var est une variable globale         */ 
 /* (i.e. non multi-mat)                                                      */
@@ -136,6 +28,7 @@ void VarSyncMng::globalSynchronize(MeshVariableRefT var)
 
   // Lire les buffers MPI reçus pour écrire les données dans var
   */
+  _checkNoThreadSync();
 
   SyncItems<ItemType>* sync_items = getSyncItems<ItemType>();
 
@@ -0,0 +1,84 @@
+#include "msgpass/VarSyncMng.h"
+
+#include <arccore/base/FatalErrorException.h>
+
+/*---------------------------------------------------------------------------*/
+/* Amorce la maj des items fantômes d'une liste de variables globales        */
+/* Les envois sont effectués et les réceptions sont en cours au retour       */
+/*---------------------------------------------------------------------------*/
+Ref<GlobalSyncListRequest> VarSyncMng::beginSync(MeshVariableSynchronizerList& vars)
+{
+  _checkNoThreadSync();
+  if (m_is_split_sync_pending) {
+    throw FatalErrorException(A_FUNCINFO, "Une synchronisation amorcee par beginSync n'est pas terminee");
+  }
+  _checkGlobalVarsOnly(vars);
+  // Buffers distincts de m_sync_buffers pour que d'autres synchros
+  // puissent avoir lieu entre beginSync et endSync
+  if (!m_split_sync_buffers) {
+    m_split_sync_buffers = new SyncBuffers(isAcceleratorAvailable());
+  }
+
+  // Synchronisation déjà faite variable par variable : rien à attendre
+  if (_synchronizeByVariable(vars)) {
+    return Ref<GlobalSyncListRequest>();
+  }
+
+  UniqueArray<ConstMultiArray2View<Integer>> owned_item_idx_pv;
+  UniqueArray<ConstMultiArray2View<Integer>> ghost_item_idx_pv;
+  _globalItemIdxPv(vars, owned_item_idx_pv, ghost_item_idx_pv);
+
+  m_is_split_sync_pending = true;
+  return makeRef(new GlobalSyncListRequest(m_vsync_algo1, vars,
+        owned_item_idx_pv, ghost_item_idx_pv, 
+        m_split_sync_buffers, &m_is_split_sync_pending));
+}
+
+/*---------------------------------------------------------------------------*/
+/* Termine une synchronisation amorcée par beginSync                         */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::endSync(Ref<GlobalSyncListRequest> req)
+{
+  if (req.get()) {
+    req->wait();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* GlobalSyncListRequest                                                     */
+/*---------------------------------------------------------------------------*/
+GlobalSyncListRequest::GlobalSyncListRequest(
+    VarSyncAlgo1* vsync_algo1,
+    MeshVariableSynchronizerList& vars,
+    ConstArrayView<ConstMultiArray2View<Integer>> owned_item_idx_pv,
+    ConstArrayView<ConstMultiArray2View<Integer>> ghost_item_idx_pv,
+    SyncBuffers* sync_buffers,
+    bool* is_pending) :
+  m_vsync_algo1       (vsync_algo1),
+  m_owned_item_idx_pv (owned_item_idx_pv),
+  m_ghost_item_idx_pv (ghost_item_idx_pv),
+  m_sync_data         (vars, m_owned_item_idx_pv, m_ghost_item_idx_pv, sync_buffers),
+  m_is_pending        (is_pending)
+{
+  m_vsync_algo1->beginSynchronize(&m_sync_data, m_req);
+}
+
+GlobalSyncListRequest::~GlobalSyncListRequest() {
+  if (!m_is_over) {
+    wait();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Termine les comms et met à jour les items fantômes des variables          */
+/*---------------------------------------------------------------------------*/
+void GlobalSyncListRequest::wait()
+{
+  if (m_is_over) {
+    return;
+  }
+  m_vsync_algo1->endSynchronize(m_req);
+  *m_is_pending = false;
+  m_is_over = true;
+}
+
@@ -0,0 +1,94 @@
+#include "msgpass/VarSyncMng.h"
+
+#include <arccore/base/FatalErrorException.h>
+
+#ifdef MSG_PASS_HAS_MPI
+#include <mpi.h>
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Retourne vrai si les comms peuvent être faites hors du thread principal   */
+/*---------------------------------------------------------------------------*/
+bool VarSyncMng::isCommThreadAvailable() const
+{
+#ifdef MSG_PASS_HAS_MPI
+  int is_init=0;
+  MPI_Initialized(&is_init);
+  if (!is_init) {
+    return false;
+  }
+  // Le thread principal peut faire des appels MPI (hors de ce gestionnaire,
+  // ex : réductions dans Arcane) pendant que le thread de progression
+  // communique : il faut MPI_THREAD_MULTIPLE
+  int provided=MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  // Le thread de progression n'appelle que MPI directement (requêtes
+  // persistantes), jamais IParallelMng qui n'est pas prévu pour
+  return provided == MPI_THREAD_MULTIPLE && m_thr_vsync_algo1->usePersistent();
+#else
+  // Sans MPI, les comms passent par IParallelMng qui n'est pas prévu pour
+  return false;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/* Amorce la maj des items fantômes d'une liste de variables globales sur    */
+/* le thread de progression des comms                                        */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::threadSyncBegin(MeshVariableSynchronizerList& vars)
+{
+  if (!m_comm_thread) {
+    m_comm_thread = new CommProgressThread();
+  }
+  _checkNoThreadSync();
+  if (m_is_split_sync_pending) {
+    throw FatalErrorException(A_FUNCINFO, "Une synchronisation amorcee par beginSync n'est pas terminee");
+  }
+  _checkGlobalVarsOnly(vars);
+
+  // Synchronisation faite variable par variable : rien à confier au thread
+  if (_synchronizeByVariable(vars)) {
+    return;
+  }
+
+  // Les SyncItems éventuellement créés ici le sont par le thread appelant
+  UniqueArray<ConstMultiArray2View<Integer>> owned_item_idx_pv;
+  UniqueArray<ConstMultiArray2View<Integer>> ghost_item_idx_pv;
+  _globalItemIdxPv(vars, owned_item_idx_pv, ghost_item_idx_pv);
+
+  // vars doit survivre à la tâche : voir ThreadSyncGuard
+  m_comm_thread->post([this, &vars, owned_item_idx_pv, ghost_item_idx_pv]() {
+    if (!m_thr_sync_buffers) {
+      m_thr_sync_buffers = new SyncBuffers(/*is_acc_avl=*/false);
+    }
+    Algo1SyncDataGlobal sync_data(vars, owned_item_idx_pv, ghost_item_idx_pv, m_thr_sync_buffers);
+    m_thr_vsync_algo1->synchronize(&sync_data);
+  });
+
+  // Trace unique, permet de vérifier que le thread est bien utilisé
+  if (m_nb_thread_sync==0) {
+    m_mesh->traceMng()->info() << "VarSyncMng : synchronisations sur le thread de progression des comms";
+  }
+  ++m_nb_thread_sync;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Attend la fin de la synchronisation amorcée par threadSyncBegin           */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::threadSyncWait()
+{
+  if (m_comm_thread) {
+    m_comm_thread->wait();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Exception si une synchronisation amorcée par threadSyncBegin est en cours */
+/* (le thread de progression communique avec les mêmes voisins)              */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::_checkNoThreadSync() const
+{
+  if (m_comm_thread && m_comm_thread->isPending()) {
+    throw FatalErrorException(A_FUNCINFO, "Une synchronisation amorcee par threadSyncBegin n'est pas terminee");
+  }
+}
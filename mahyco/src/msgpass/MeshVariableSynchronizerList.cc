@@ -1,5 +1,6 @@
 #include "msgpass/MeshVariableSynchronizerList.h"
 #include "msgpass/SyncBuffers.h"
+#include "msgpass/PackTransfer.h"
 
 /*---------------------------------------------------------------------------*/
 /* CellMatVarScalSync<DataType> : a Cell multi-mat variable to synchronize   */
@@ -79,6 +80,76 @@ void CellMatVarScalSync<DataType>::asyncUnpackFromBuf(
   }; // asynchrone
 }
 
+/*---------------------------------------------------------------------------*/
+/* GlobalVarSync : a global (scalar or array) mesh variable to synchronize   */
+/*---------------------------------------------------------------------------*/
+// Nb de DataType par item
+template<typename ItemType, typename DataType>
+Integer global_var_degree(const MeshVariableScalarRefT<ItemType, DataType>&) {
+  return 1;
+}
+
+template<typename ItemType, typename DataType>
+Integer global_var_degree(const MeshVariableArrayRefT<ItemType, DataType>& var) {
+  return var.arraySize();
+}
+
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+GlobalVarSync<ItemType, DataType, MeshVarRefT>::GlobalVarSync(
+    MeshVarRefT<ItemType, DataType> var) :
+  IGlobalVarSync(),
+  m_var (var)
+{
+  m_degree = global_var_degree(m_var);
+}
+
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+GlobalVarSync<ItemType, DataType, MeshVarRefT>::~GlobalVarSync() {
+}
+
+//! Kind of the items of the variable
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+eItemKind GlobalVarSync<ItemType, DataType, MeshVarRefT>::itemKind() const {
+  return ItemTraitsT<ItemType>::kind();
+}
+
+//! Different sizes/properties depending on unit type
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+IMeshVarSync::SizeInfos GlobalVarSync<ItemType, DataType, MeshVarRefT>::sizeInfos() const {
+  return {alignof(DataType), sizeof(DataType), sizeof(DataType)*m_degree};
+}
+
+//! Estimate an upper bound of the buffer size to pack <item_sizes> values
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+Int64 GlobalVarSync<ItemType, DataType, MeshVarRefT>::estimatedMaxBufSz(
+    IntegerConstArrayView item_sizes) const
+{
+  return SyncBuffers::estimatedMaxBufSz<DataType>(item_sizes, m_degree);
+}
+
+//! Pack "shared" items (item_idx) into the buffer (buf) on host
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+void GlobalVarSync<ItemType, DataType, MeshVarRefT>::packIntoBuf(
+    IntegerConstArrayView item_idx, ArrayView<Byte> buf)
+{
+  pack_var2buf(item_idx, m_var, buf);
+}
+
+//! Unpack buffer (buf) into "ghost" items (item_idx) on host
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+void GlobalVarSync<ItemType, DataType, MeshVarRefT>::unpackFromBuf(
+    IntegerConstArrayView item_idx, ArrayView<Byte> buf)
+{
+  unpack_buf2var(item_idx, buf, m_var);
+}
+
+//! Synchronize the variable with Arcane
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+void GlobalVarSync<ItemType, DataType, MeshVarRefT>::synchronize()
+{
+  m_var.synchronize();
+}
+
 /*---------------------------------------------------------------------------*/
 /* MeshVariableSynchronizerList : List of mesh variables to synchronize      */
 /*---------------------------------------------------------------------------*/
@@ -91,7 +162,12 @@ MeshVariableSynchronizerList::~MeshVariableSynchronizerList() {
   for(auto v : m_vars) {
     delete v;
   }
-  m_buf_addr_mng->reset();
+  for(auto v : m_global_vars) {
+    delete v;
+  }
+  if (m_buf_addr_mng) {
+    m_buf_addr_mng->reset();
+  }
 }
 
 //! Add a multi-mat variable into the list of variables to synchronize
@@ -100,11 +176,28 @@ void MeshVariableSynchronizerList::add(CellMaterialVariableScalarRef<DataType> v
   m_vars.add(new CellMatVarScalSync<DataType>(var_menv, m_buf_addr_mng));
 }
 
+//! Add a global scalar variable into the list of variables to synchronize
+template<typename ItemType, typename DataType>
+void MeshVariableSynchronizerList::add(MeshVariableScalarRefT<ItemType, DataType> var) {
+  m_global_vars.add(new GlobalVarSync<ItemType, DataType, MeshVariableScalarRefT>(var));
+}
+
+//! Add a global array variable into the list of variables to synchronize
+template<typename ItemType, typename DataType>
+void MeshVariableSynchronizerList::add(MeshVariableArrayRefT<ItemType, DataType> var) {
+  m_global_vars.add(new GlobalVarSync<ItemType, DataType, MeshVariableArrayRefT>(var));
+}
+
 //! Return the list of variables to synchronize
 ConstArrayView<IMeshVarSync*> MeshVariableSynchronizerList::varsList() const {
   return m_vars;
 }
 
+//! Return the list of global variables to synchronize
+ConstArrayView<IGlobalVarSync*> MeshVariableSynchronizerList::globalVarsList() const {
+  return m_global_vars;
+}
+
 //! Asynchronous pointers tranfer onto device
 void MeshVariableSynchronizerList::asyncHToD(RunQueue& queue) {
   m_buf_addr_mng->asyncCpyHToD(queue);
@@ -123,3 +216,17 @@ INST_MESH_VAR_SYNC_LIST_ADD(Real);
 INST_MESH_VAR_SYNC_LIST_ADD(Real3);
 INST_MESH_VAR_SYNC_LIST_ADD(Real3x3);
 
+#define INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(__ItemType__, __DataType__) \
+  template void MeshVariableSynchronizerList::add(MeshVariableScalarRefT<__ItemType__, __DataType__> var); \
+  template void MeshVariableSynchronizerList::add(MeshVariableArrayRefT<__ItemType__, __DataType__> var)
+
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Cell, Integer);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Cell, Real);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Cell, Real3);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Node, Integer);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Node, Real);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Node, Real3);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Face, Integer);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Face, Real);
+INST_MESH_VAR_SYNC_LIST_ADD_GLOBAL(Face, Real3);
+
@@ -4,6 +4,8 @@
 #include "accenv/MultiEnvUtils.h"
 
 #include <arcane/materials/MeshMaterialVariable.h>
+#include <arcane/MeshVariableScalarRef.h>
+#include <arcane/MeshVariableArrayRef.h>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -75,6 +77,70 @@ class CellMatVarScalSync : public IMeshVarSync {
   MultiEnvVarHD<DataType> m_menv_var;  //! View memories on multi-mat data in HOST/DEVICE
 };
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Interface of a global (i.e. non multi-mat) mesh variable to synchronize
+ */
+class IGlobalVarSync {
+ public:
+  IGlobalVarSync() {}
+  virtual ~IGlobalVarSync() {}
+
+  //! Kind of the items of the variable
+  virtual eItemKind itemKind() const = 0;
+
+  //! Different sizes/properties depending on unit type
+  virtual IMeshVarSync::SizeInfos sizeInfos() const = 0;
+
+  //! Estimate an upper bound of the buffer size to pack <item_sizes> values
+  virtual Int64 estimatedMaxBufSz(IntegerConstArrayView item_sizes) const = 0;
+
+  //! Pack "shared" items (item_idx) into the buffer (buf) on host
+  virtual void packIntoBuf(IntegerConstArrayView item_idx, ArrayView<Byte> buf) = 0;
+
+  //! Unpack buffer (buf) into "ghost" items (item_idx) on host
+  virtual void unpackFromBuf(IntegerConstArrayView item_idx, ArrayView<Byte> buf) = 0;
+
+  //! Synchronize the variable with Arcane (when no grouped message is possible)
+  virtual void synchronize() = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief a global (scalar or array) mesh variable to synchronize
+ */
+template<typename ItemType, typename DataType, template<typename, typename> class MeshVarRefT>
+class GlobalVarSync : public IGlobalVarSync {
+ public:
+  GlobalVarSync(MeshVarRefT<ItemType, DataType> var);
+
+  virtual ~GlobalVarSync();
+
+  //! Kind of the items of the variable
+  eItemKind itemKind() const override;
+
+  //! Different sizes/properties depending on unit type
+  IMeshVarSync::SizeInfos sizeInfos() const override;
+
+  //! Estimate an upper bound of the buffer size to pack <item_sizes> values
+  Int64 estimatedMaxBufSz(IntegerConstArrayView item_sizes) const override;
+
+  //! Pack "shared" items (item_idx) into the buffer (buf) on host
+  void packIntoBuf(IntegerConstArrayView item_idx, ArrayView<Byte> buf) override;
+
+  //! Unpack buffer (buf) into "ghost" items (item_idx) on host
+  void unpackFromBuf(IntegerConstArrayView item_idx, ArrayView<Byte> buf) override;
+
+  //! Synchronize the variable with Arcane
+  void synchronize() override;
+
+ protected:
+  MeshVarRefT<ItemType, DataType> m_var;  //! Variable to synchronize
+  Integer m_degree=1;  //! Number of DataType per item
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -90,15 +156,27 @@ class MeshVariableSynchronizerList {
   template<typename DataType>
   void add(CellMaterialVariableScalarRef<DataType> var_menv);
 
+  //! Add a global scalar variable into the list of variables to synchronize
+  template<typename ItemType, typename DataType>
+  void add(MeshVariableScalarRefT<ItemType, DataType> var);
+
+  //! Add a global array variable into the list of variables to synchronize
+  template<typename ItemType, typename DataType>
+  void add(MeshVariableArrayRefT<ItemType, DataType> var);
+
   //! Return the list of variables to synchronize
   ConstArrayView<IMeshVarSync*> varsList() const;
 
+  //! Return the list of global variables to synchronize
+  ConstArrayView<IGlobalVarSync*> globalVarsList() const;
+
   //! Asynchronous pointers tranfer onto device
   void asyncHToD(RunQueue& queue);
 
  protected:
   BufAddrMng* m_buf_addr_mng=nullptr;
   UniqueArray<IMeshVarSync*> m_vars;  //! List of variables to synchronize
+  UniqueArray<IGlobalVarSync*> m_global_vars;  //! List of global variables to synchronize
 };
 
 #endif
@@ -3,6 +3,8 @@
 #include <arcane/utils/IMemoryRessourceMng.h>
 #include <arcane/utils/IndexOutOfRangeException.h>
 
+#include <algorithm>
+
 /*---------------------------------------------------------------------------*/
 /* MultiBufView                                                              */
 /*---------------------------------------------------------------------------*/
@@ -447,6 +449,80 @@ MultiBufView2 SyncBuffers::multiBufViewVars(
 }
 
 
+/*---------------------------------------------------------------------------*/
+/* */
+/*---------------------------------------------------------------------------*/
+MultiBufView2 SyncBuffers::_multiBufViewVars(
+    ConstArrayView<IMeshVarSync::SizeInfos> size_infos_pv,
+    ConstArrayView<IntegerConstArrayView> item_sizes_pv,
+    Span<Byte> buf_bytes) {
+
+  Integer nb_var = size_infos_pv.size();  // nb de variables à synchroniser
+  Integer nb_nei = (nb_var>0 ? item_sizes_pv[0].size() : 0); // nb de voisins
+  UniqueArray<Byte*> ptrs(nb_nei*nb_var); // le pointeur de base du buffer par voisin et par variable
+  Int64UniqueArray sizes_in_bytes(nb_nei*nb_var); // la taille en octets du buffer par voisin et par variable
+
+  // Le plus grand alignement parmi toutes les variables
+  size_t max_align = 1;
+  for(Integer ivar=0 ; ivar<nb_var ; ++ivar) {
+    max_align = std::max(max_align, size_infos_pv[ivar].alignOf);
+  }
+
+  Byte* cur_ptr{buf_bytes.data()};
+  size_t available_space = buf_bytes.size();
+
+  for(Integer inei=0 ; inei<nb_nei ; ++inei) {
+    for(Integer ivar=0 ; ivar<nb_var ; ++ivar) {
+
+      // La première variable d'un voisin est alignée sur max_align, les suivantes sur leur propre alignOf
+      const auto& size_infos = size_infos_pv[ivar];
+      size_t align = (ivar==0 ? max_align : size_infos.alignOf);
+
+      void* cur_ptr_v = static_cast<void*>(cur_ptr);
+      if (!std::align(align, size_infos.sizeOf, cur_ptr_v, available_space)) {
+        throw NotSupportedException(A_FUNCINFO, 
+            String("Espace insuffisant pour aligner les données dans le buffer d'après std::align"));
+      }
+      cur_ptr = static_cast<Byte*>(cur_ptr_v); // cur_ptr_v a été potentiellement modifié
+
+      // Calcul en octets de l'occupation des valeurs de la variable ivar pour le voisin inei
+      size_t sz_nei_in_bytes = item_sizes_pv[ivar][inei]*size_infos.sizeOfItem;
+
+      ptrs[inei*nb_var+ivar] = cur_ptr;
+      sizes_in_bytes[inei*nb_var+ivar] = sz_nei_in_bytes;
+
+      if (sz_nei_in_bytes > available_space) {
+        throw NotSupportedException(A_FUNCINFO, 
+            String("Espace insuffisant pour aligner les données dans le buffer, available_space va devenir négatif"));
+      }
+      cur_ptr += sz_nei_in_bytes; // ici, cur_ptr n'est plus forcement aligné
+      available_space -= sz_nei_in_bytes;
+    }
+  }
+
+  return MultiBufView2(ptrs, sizes_in_bytes, nb_nei, nb_var);
+}
+
+/*---------------------------------------------------------------------------*/
+/* */
+/*---------------------------------------------------------------------------*/
+MultiBufView2 SyncBuffers::multiBufViewVars(
+    ConstArrayView<IMeshVarSync::SizeInfos> size_infos_pv,
+    ConstArrayView<IntegerConstArrayView> item_sizes_pv, Integer imem) {
+
+  auto& buf_mem = m_buf_mem[imem];
+  Byte* new_ptr = buf_mem.m_buf->data()+buf_mem.m_first_av_pos;
+  Int64 av_space = buf_mem.m_buf->size()-buf_mem.m_first_av_pos;
+  Span<Byte> buf_bytes(new_ptr, av_space);
+
+  auto mb2 = _multiBufViewVars(size_infos_pv, item_sizes_pv, buf_bytes);
+
+  auto rg{mb2.rangeSpan()}; // Encapsule [beg_ptr, end_ptr[
+  Byte* end_ptr = rg.data()+rg.size();
+  buf_mem.m_first_av_pos = (end_ptr - buf_mem.m_buf->data());
+  return mb2;
+}
+
 /*---------------------------------------------------------------------------*/
 /* INSTANCIATIONS STATIQUES                                                  */
 /*---------------------------------------------------------------------------*/
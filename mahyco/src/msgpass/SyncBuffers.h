@@ -102,6 +102,14 @@ class SyncBuffers {
     ConstArrayView<IMeshVarSync*> vars,
     IntegerConstArrayView item_sizes, Integer imem);
 
+  /*!
+   * \brief Construit des vues par voisin et par variable, 
+   * chaque variable ayant son propre nb d'items par voisin (item_sizes_pv[ivar])
+   */
+  MultiBufView2 multiBufViewVars(
+    ConstArrayView<IMeshVarSync::SizeInfos> size_infos_pv,
+    ConstArrayView<IntegerConstArrayView> item_sizes_pv, Integer imem);
+
  protected:
   /*!
    * \brief A partir de la vue sur un buffer déjà alloué, construit une vue par voisin des buffers
@@ -118,6 +126,16 @@ class SyncBuffers {
       IntegerConstArrayView item_sizes,
       Span<Byte> buf_bytes);
 
+  /*!
+   * \brief Idem mais avec un nb d'items par voisin propre à chaque variable.
+   * Le début du bloc de chaque voisin est aligné sur le plus grand alignOf
+   * afin que le découpage soit le même chez l'émetteur et chez le récepteur
+   */
+  MultiBufView2 _multiBufViewVars(
+      ConstArrayView<IMeshVarSync::SizeInfos> size_infos_pv,
+      ConstArrayView<IntegerConstArrayView> item_sizes_pv,
+      Span<Byte> buf_bytes);
+
  protected:
   struct BufMem {
     UniqueArray<Byte> *m_buf=nullptr;
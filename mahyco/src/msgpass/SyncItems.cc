@@ -23,6 +23,11 @@ eItemKind get_item_kind<Node>() {
   return IK_Node;
 }
 
+template<>
+eItemKind get_item_kind<Face>() {
+  return IK_Face;
+}
+
 // Retourne le groupe de tous les items d'un ItemType donné
 template<typename ItemType>
 ItemGroupT<ItemType> get_all_items(IMesh* mesh) {
@@ -40,6 +45,11 @@ ItemGroupT<Node> get_all_items(IMesh* mesh) {
   return mesh->allNodes();
 }
 
+template<>
+ItemGroupT<Face> get_all_items(IMesh* mesh) {
+  return mesh->allFaces();
+}
+
 // Retourne le groupe des items "own" d'un ItemType donné
 template<typename ItemType>
 ItemGroupT<ItemType> get_own_items(IMesh* mesh) {
@@ -57,6 +67,11 @@ ItemGroupT<Node> get_own_items(IMesh* mesh) {
   return mesh->ownNodes();
 }
 
+template<>
+ItemGroupT<Face> get_own_items(IMesh* mesh) {
+  return mesh->ownFaces();
+}
+
 // Retourne le nom associé ItemType donné
 template<typename ItemType>
 const char* get_string_items() {
@@ -74,6 +89,11 @@ const char* get_string_items<Node>() {
   return "Node";
 }
 
+template<>
+const char* get_string_items<Face>() {
+  return "Face";
+}
+
 /*---------------------------------------------------------------------------*/
 /* Encapsule la liste des items à envoyer/recevoir pour un type d'item donné */
 /*---------------------------------------------------------------------------*/
@@ -93,6 +113,26 @@ SyncItems<ItemType>::SyncItems(IMesh* mesh, Int32ConstArrayView neigh_ranks,
   
   Integer nb_nei = neigh_ranks.size();
 
+  // Les voisins de la famille peuvent être un sous-ensemble de neigh_ranks
+  // (ou être dans un autre ordre) : on retrouve l'indice de chaque voisin
+  // dans le synchroniseur, -1 si aucun item de ce type n'est échangé avec lui
+  Int32ConstArrayView family_ranks = var_sync->communicatingRanks();
+  IntegerUniqueArray family_index(nb_nei);
+  for(Integer inei=0 ; inei<nb_nei ; ++inei) {
+    family_index[inei] = -1;
+    for(Integer ifam=0 ; ifam<family_ranks.size() ; ++ifam) {
+      if (family_ranks[ifam]==neigh_ranks[inei]) {
+        family_index[inei] = ifam;
+      }
+    }
+  }
+  auto shared_items = [&](Integer inei) {
+    return (family_index[inei]<0 ? Int32ConstArrayView() : var_sync->sharedItems(family_index[inei]));
+  };
+  auto ghost_items = [&](Integer inei) {
+    return (family_index[inei]<0 ? Int32ConstArrayView() : var_sync->ghostItems(family_index[inei]));
+  };
+
   // "shared" ou "owned" : les items intérieurs au sous-domaine et qui doivent être envoyés
   // "ghost" : les items fantômes pour lesquels on va recevoir des informations
   m_indexes_owned_item_pn.resize(nb_nei);
@@ -103,8 +143,8 @@ SyncItems<ItemType>::SyncItems(IMesh* mesh, Int32ConstArrayView neigh_ranks,
   Integer accu_nb_owned=0;
   Integer accu_nb_ghost=0;
   for(Integer inei=0 ; inei<nb_nei ; ++inei) {
-    m_nb_owned_item_pn[inei] = var_sync->sharedItems(inei).size();
-    m_nb_ghost_item_pn[inei] = var_sync->ghostItems(inei).size();
+    m_nb_owned_item_pn[inei] = shared_items(inei).size();
+    m_nb_ghost_item_pn[inei] = ghost_items(inei).size();
 
     m_indexes_owned_item_pn[inei] = accu_nb_owned;
     m_indexes_ghost_item_pn[inei] = accu_nb_ghost;
@@ -137,8 +177,8 @@ SyncItems<ItemType>::SyncItems(IMesh* mesh, Int32ConstArrayView neigh_ranks,
   };
 
   for(Integer inei=0 ; inei<nb_nei ; ++inei) {
-    lids2itemidx(var_sync->sharedItems(inei), owned_item_idx_pn[inei]);
-    lids2itemidx(var_sync->ghostItems(inei) , ghost_item_idx_pn[inei]);
+    lids2itemidx(shared_items(inei), owned_item_idx_pn[inei]);
+    lids2itemidx(ghost_items(inei) , ghost_item_idx_pn[inei]);
   }
 
   // Les groupes d'items
@@ -229,4 +269,5 @@ SyncItems<ItemType>::SyncItems(IMesh* mesh, Int32ConstArrayView neigh_ranks,
 
 INST_SYNC_ITEMS(Cell);
 INST_SYNC_ITEMS(Node);
+INST_SYNC_ITEMS(Face);
 
@@ -4,19 +4,189 @@
 #include <arcane/utils/UniqueArray.h>
 #include <arccore/base/FatalErrorException.h>
 
+#include <limits>
+
+#ifdef MSG_PASS_HAS_MPI
+#include <mpi.h>
+
+/*---------------------------------------------------------------------------*/
+/* \class PersistentPattern                                                  */
+/* \brief Persistent requests for given recv/send buffers                    */
+/*---------------------------------------------------------------------------*/
+struct PersistentPattern {
+  UniqueArray<Byte*> m_ptrs;  //! Addresses of the recv buffers then of the send buffers
+  Int64UniqueArray m_sizes;  //! Sizes of the recv buffers then of the send buffers
+  UniqueArray<MPI_Request> m_requests;  //! Recv requests then send requests
+  bool m_is_active=false;  //! True while its requests are started (beginSynchronize/endSynchronize)
+};
+
+/*---------------------------------------------------------------------------*/
+/* \class PersistentPatterns                                                 */
+/* \brief Communication patterns built with persistent MPI requests          */
+/*   A pattern is identified by the addresses and sizes of the recv/send     */
+/*   buffers of every neighbour. SyncBuffers reuses the same memory from one */
+/*   call to another so that the same list of variables finds its pattern   */
+/*   back and only restarts its requests (MPI_Startall/MPI_Start).           */
+/*---------------------------------------------------------------------------*/
+class PersistentPatterns {
+ public:
+  using Pattern = PersistentPattern;
+
+ public:
+  PersistentPatterns(MPI_Comm comm, Int32ConstArrayView neigh_ranks, int tag) :
+    m_tag         (tag),
+    m_comm        (comm),
+    m_neigh_ranks (neigh_ranks)
+  {
+    m_nb_nei = m_neigh_ranks.size();
+    m_done_indexes.resize(m_nb_nei);
+  }
+
+  ~PersistentPatterns() {
+    // Un pattern encore démarré n'est pas libéré (ses requêtes sont en cours)
+    for(Pattern* pat : m_patterns) {
+      if (!pat->m_is_active) {
+        _freePattern(pat);
+      }
+    }
+  }
+
+  //! Find the pattern of the buffers of sync_data, register it if it is new
+  Pattern* pattern(IAlgo1SyncData* sync_data) {
+    UniqueArray<Byte*> ptrs(2*m_nb_nei);
+    Int64UniqueArray sizes(2*m_nb_nei);
+    for(Integer inei=0 ; inei<m_nb_nei ; ++inei) {
+      auto byte_buf_rcv = sync_data->recvBuf(inei);
+      auto byte_buf_snd = sync_data->sendBuf(inei);
+      ptrs [inei]          = byte_buf_rcv.data();
+      sizes[inei]          = byte_buf_rcv.size();
+      ptrs [m_nb_nei+inei] = byte_buf_snd.data();
+      sizes[m_nb_nei+inei] = byte_buf_snd.size();
+    }
+
+    for(Pattern* pat : m_patterns) {
+      if (pat->m_ptrs==ptrs && pat->m_sizes==sizes) {
+        return pat;
+      }
+    }
+
+    // Nouveau pattern : on libère le plus ancien (non démarré) si on en a trop
+    if (m_patterns.size()>=m_max_nb_pattern) {
+      for(Integer ipat=0 ; ipat<m_patterns.size() ; ++ipat) {
+        if (!m_patterns[ipat]->m_is_active) {
+          _freePattern(m_patterns[ipat]);
+          m_patterns.remove(ipat);
+          break;
+        }
+      }
+    }
+
+    Pattern* pat = new Pattern();
+    pat->m_ptrs = ptrs;
+    pat->m_sizes = sizes;
+    pat->m_requests.resize(2*m_nb_nei);
+    for(Integer inei=0 ; inei<m_nb_nei ; ++inei) {
+      Int32 rank_nei = m_neigh_ranks[inei]; // le rang du inei-ième voisin
+      MPI_Recv_init(ptrs[inei], _count(sizes[inei]), MPI_BYTE, 
+          rank_nei, m_tag, m_comm, &(pat->m_requests[inei]));
+      MPI_Send_init(ptrs[m_nb_nei+inei], _count(sizes[m_nb_nei+inei]), MPI_BYTE, 
+          rank_nei, m_tag, m_comm, &(pat->m_requests[m_nb_nei+inei]));
+    }
+    m_patterns.add(pat);
+    return pat;
+  }
+
+  //! Free all registered patterns, none of them must be started
+  void reset() {
+    for(Pattern* pat : m_patterns) {
+      if (pat->m_is_active) {
+        throw FatalErrorException(A_FUNCINFO, "Un pattern de comms persistantes est en cours d'utilisation");
+      }
+    }
+    for(Pattern* pat : m_patterns) {
+      _freePattern(pat);
+    }
+    m_patterns.clear();
+  }
+
+  //! Working array for MPI_Waitsome
+  IntegerArrayView doneIndexes() {
+    return m_done_indexes;
+  }
+
+ protected:
+  void _freePattern(Pattern* pat) {
+    for(MPI_Request& req : pat->m_requests) {
+      MPI_Request_free(&req);
+    }
+    delete pat;
+  }
+
+  static int _count(Int64 sz) {
+    if (sz>std::numeric_limits<int>::max()) {
+      throw FatalErrorException(A_FUNCINFO, "Message trop grand pour une requete persistante");
+    }
+    return static_cast<int>(sz);
+  }
+
+ protected:
+  int m_tag;  //! Tag of all the messages of these patterns
+  static const Integer m_max_nb_pattern = 16;  //! Max number of simultaneously registered patterns
+
+  MPI_Comm m_comm;
+  Int32ConstArrayView m_neigh_ranks;
+  Integer m_nb_nei=0;
+  UniqueArray<Pattern*> m_patterns;
+  IntegerUniqueArray m_done_indexes;
+};
+#else
+class PersistentPatterns {
+};
+#endif
+
 /*---------------------------------------------------------------------------*/
 /* \class VarSyncAlgo1                                                       */
 /* \brief Algorithm (v1) to synchronize mesh variables                       */
 /*---------------------------------------------------------------------------*/
 
-VarSyncAlgo1::VarSyncAlgo1(IParallelMng* pm, Int32ConstArrayView neigh_ranks) :
+VarSyncAlgo1::VarSyncAlgo1(IParallelMng* pm, Int32ConstArrayView neigh_ranks,
+    bool use_persistent, int persistent_tag) :
   m_pm          (pm),
   m_neigh_ranks (neigh_ranks)
 {
   m_nb_nei = m_neigh_ranks.size();
+
+#ifdef MSG_PASS_HAS_MPI
+  // Les requêtes persistantes nécessitent le communicateur MPI du sous-domaine
+  // (pas disponible en mémoire partagée)
+  void* comm_ptr = m_pm->getMPICommunicator();
+  if (use_persistent && comm_ptr && !m_pm->isThreadImplementation() && 
+      !m_pm->isHybridImplementation()) {
+    m_patterns = new PersistentPatterns(*static_cast<MPI_Comm*>(comm_ptr), m_neigh_ranks, persistent_tag);
+  }
+#endif
 }
 
 VarSyncAlgo1::~VarSyncAlgo1() {
+  delete m_patterns;
+}
+
+/*---------------------------------------------------------------------------*/
+/* True if persistent requests are used to communicate                       */
+/*---------------------------------------------------------------------------*/
+bool VarSyncAlgo1::usePersistent() const {
+  return m_patterns!=nullptr;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Free all registered communication patterns                                */
+/*---------------------------------------------------------------------------*/
+void VarSyncAlgo1::resetPatterns() {
+#ifdef MSG_PASS_HAS_MPI
+  if (m_patterns) {
+    m_patterns->reset();
+  }
+#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -24,16 +194,146 @@ VarSyncAlgo1::~VarSyncAlgo1() {
 /*---------------------------------------------------------------------------*/
 void VarSyncAlgo1::synchronize(IAlgo1SyncData* sync_data)
 {
+  Algo1SyncRequest req;
+  beginSynchronize(sync_data, req);
+  endSynchronize(req);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Start the synchronization: receipts are posted and sendings are packed    */
+/* and posted                                                                */
+/*---------------------------------------------------------------------------*/
+void VarSyncAlgo1::beginSynchronize(IAlgo1SyncData* sync_data, Algo1SyncRequest& req)
+{
+  if (!req.isOver()) {
+    throw FatalErrorException(A_FUNCINFO, "La requete est deja utilisee par une synchronisation en cours");
+  }
   if (m_nb_nei==0 || sync_data->isEmpty()) {
     return;
   }
 
+  req.m_sync_data = sync_data;
+  if (m_patterns) {
+    _beginPersistent(req);
+  } else {
+    _beginNonBlocking(req);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Terminate a synchronization started by beginSynchronize                   */
+/*---------------------------------------------------------------------------*/
+void VarSyncAlgo1::endSynchronize(Algo1SyncRequest& req)
+{
+  if (req.isOver()) {
+    return;
+  }
+
+  if (m_patterns) {
+    _endPersistent(req);
+  } else {
+    _endNonBlocking(req);
+  }
+  req.m_sync_data = nullptr;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Synchronization by restarting the persistent requests of a pattern        */
+/*---------------------------------------------------------------------------*/
+void VarSyncAlgo1::_beginPersistent(Algo1SyncRequest& req)
+{
+#ifdef MSG_PASS_HAS_MPI
+  IAlgo1SyncData* sync_data = req.m_sync_data;
+
+  // Step before the first communications
+  sync_data->initComm();
+
+  // Les buffers sont connus après initComm(), on retrouve (ou on crée) le pattern
+  PersistentPatterns::Pattern* pat = m_patterns->pattern(sync_data);
+  if (pat->m_is_active) {
+    throw FatalErrorException(A_FUNCINFO, "Les buffers sont deja utilises par une synchronisation en cours");
+  }
+  pat->m_is_active = true;
+  req.m_pattern = pat;
+
+  MPI_Request* rcv_requests = pat->m_requests.data();
+  MPI_Request* snd_requests = rcv_requests + m_nb_nei;
+
+  // On redémarre toutes les réceptions en une fois
+  MPI_Startall(m_nb_nei, rcv_requests);
+
+  sync_data->initSendings();
+
+  // On redémarre chaque envoi dès que son buffer est prêt
+  for(Integer inei=0 ; inei<m_nb_nei ; ++inei) {
+    sync_data->finalizePackBeforeSend(inei);
+    MPI_Start(&(snd_requests[inei]));
+  }
+
+  sync_data->finalizeSendings();
+#else
+  _beginNonBlocking(req);
+#endif
+}
+
+void VarSyncAlgo1::_endPersistent(Algo1SyncRequest& req)
+{
+#ifdef MSG_PASS_HAS_MPI
+  IAlgo1SyncData* sync_data = req.m_sync_data;
+  PersistentPatterns::Pattern* pat = req.m_pattern;
+
+  MPI_Request* rcv_requests = pat->m_requests.data();
+  MPI_Request* snd_requests = rcv_requests + m_nb_nei;
+
+  // Une requête persistante terminée devient inactive et est ignorée par
+  // MPI_Waitsome : pas besoin de compacter le tableau des requêtes en attente
+  IntegerArrayView done_indexes = m_patterns->doneIndexes();
+  Integer nb_pending_rcv = m_nb_nei;
+
+  while(nb_pending_rcv>0) {
+    int nb_req_done=0;
+    MPI_Waitsome(m_nb_nei, rcv_requests, &nb_req_done, 
+        done_indexes.data(), MPI_STATUSES_IGNORE);
+    if (nb_req_done==MPI_UNDEFINED) {
+      throw FatalErrorException(A_FUNCINFO, "Plus de requete de reception active");
+    }
+
+    for(Integer idone=0 ; idone<nb_req_done ; ++idone) {
+      nb_pending_rcv--;
+
+      // Maintenant qu'on a reçu le buffer pour le inei-ième voisin, 
+      // on post-traite les données reçues
+      sync_data->unpackAfterRecv(done_indexes[idone]);
+    }
+  }
+
+  // Il peut rester des envois en cours
+  MPI_Waitall(m_nb_nei, snd_requests, MPI_STATUSES_IGNORE);
+
+  pat->m_is_active = false;
+  req.m_pattern = nullptr;
+
+  sync_data->finalizeReceipts();
+#else
+  _endNonBlocking(req);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/* Synchronization with fresh non-blocking requests at each call             */
+/*---------------------------------------------------------------------------*/
+void VarSyncAlgo1::_beginNonBlocking(Algo1SyncRequest& req)
+{
+  IAlgo1SyncData* sync_data = req.m_sync_data;
+
   // Step before the first communications
   sync_data->initComm();
 
   // L'échange proprement dit des valeurs de var
-  UniqueArray<Parallel::Request> requests(2*m_nb_nei);
-  IntegerUniqueArray msg_types(2*m_nb_nei); // nature des messages 
+  UniqueArray<Parallel::Request>& requests = req.m_requests;
+  IntegerUniqueArray& msg_types = req.m_msg_types; // nature des messages 
+  requests.resize(2*m_nb_nei);
+  msg_types.resize(2*m_nb_nei);
 
   // On amorce les réceptions
   for(Integer inei=0 ; inei<m_nb_nei ; ++inei) {
@@ -60,6 +360,13 @@ void VarSyncAlgo1::synchronize(IAlgo1SyncData* sync_data)
   }
 
   sync_data->finalizeSendings();
+}
+
+void VarSyncAlgo1::_endNonBlocking(Algo1SyncRequest& req)
+{
+  IAlgo1SyncData* sync_data = req.m_sync_data;
+  UniqueArray<Parallel::Request>& requests = req.m_requests;
+  IntegerUniqueArray& msg_types = req.m_msg_types;
 
   // Maitenant que toutes les requêtes de comms sont amorcées, il faut les terminer
   if (2*m_nb_nei!=requests.size()) {
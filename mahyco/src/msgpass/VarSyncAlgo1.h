@@ -4,6 +4,28 @@
 #include "msgpass/IAlgo1SyncData.h"
 
 #include <arcane/IParallelMng.h>
+#include <arcane/utils/UniqueArray.h>
+
+// Patterns de comms persistantes, définis dans VarSyncAlgo1.cc
+class PersistentPatterns;
+struct PersistentPattern;
+
+/*---------------------------------------------------------------------------*/
+/* \class Algo1SyncRequest                                                   */
+/* \brief State of a synchronization started by VarSyncAlgo1::beginSynchronize */
+/*---------------------------------------------------------------------------*/
+class Algo1SyncRequest {
+  friend class VarSyncAlgo1;
+ public:
+  //! True if there is no pending synchronization
+  bool isOver() const { return m_sync_data==nullptr; }
+
+ protected:
+  IAlgo1SyncData* m_sync_data=nullptr;  //! Data of the pending synchronization
+  UniqueArray<Parallel::Request> m_requests;  //! Recv requests then send requests (non-blocking)
+  IntegerUniqueArray m_msg_types;  //! >0 for a receipt, <0 for a sending (non-blocking)
+  PersistentPattern* m_pattern=nullptr;  //! Restarted pattern (persistent)
+};
 
 /*---------------------------------------------------------------------------*/
 /* \class VarSyncAlgo1                                                       */
@@ -11,16 +33,40 @@
 /*---------------------------------------------------------------------------*/
 class VarSyncAlgo1 {
  public:
-  VarSyncAlgo1(IParallelMng* pm, Int32ConstArrayView neigh_ranks);
+  //! persistent_tag : tag of the persistent messages, distinct for two instances used at the same time
+  VarSyncAlgo1(IParallelMng* pm, Int32ConstArrayView neigh_ranks, 
+      bool use_persistent=false, int persistent_tag=1010);
   virtual ~VarSyncAlgo1();
 
   //! Synchronize variables encapsulated into sync_data
   void synchronize(IAlgo1SyncData* sync_data);
+
+  //! Start the synchronization: receipts are posted and sendings are packed and posted
+  void beginSynchronize(IAlgo1SyncData* sync_data, Algo1SyncRequest& req);
+
+  //! Terminate a synchronization started by beginSynchronize
+  void endSynchronize(Algo1SyncRequest& req);
+
+  //! True if persistent requests are used to communicate
+  bool usePersistent() const;
+
+  //! Free all registered communication patterns (none of them must be in use)
+  void resetPatterns();
+
+ protected:
+  //! Synchronization with fresh non-blocking requests at each call
+  void _beginNonBlocking(Algo1SyncRequest& req);
+  void _endNonBlocking(Algo1SyncRequest& req);
+
+  //! Synchronization by restarting the persistent requests of a registered pattern
+  void _beginPersistent(Algo1SyncRequest& req);
+  void _endPersistent(Algo1SyncRequest& req);
+
  protected:
   IParallelMng* m_pm=nullptr;  //! To perform send/recv
   Int32ConstArrayView m_neigh_ranks;  //! List of neighbour ranks
   Integer m_nb_nei;  //! Number of neighbours (m_neigh_ranks.size())
+  PersistentPatterns* m_patterns=nullptr;  //! Registered patterns (nullptr if no persistent comms)
 };
 
 #endif
-
@@ -5,6 +5,7 @@
 #include <arcane/IItemFamily.h>
 #include <arcane/IParallelMng.h>
 #include <arcane/utils/NotSupportedException.h>
+#include <arccore/base/FatalErrorException.h>
 
 // Définie ailleurs
 bool is_comm_device_aware();
@@ -12,7 +13,8 @@ bool is_comm_device_aware();
 /*---------------------------------------------------------------------------*/
 /* Gère les synchronisations des mailles fantômes par Message Passing        */
 /*---------------------------------------------------------------------------*/
-VarSyncMng::VarSyncMng(IMesh* mesh, ax::Runner& runner, AccMemAdviser* acc_mem_adv) :
+VarSyncMng::VarSyncMng(IMesh* mesh, ax::Runner& runner, AccMemAdviser* acc_mem_adv,
+    bool use_persistent_comm) :
   m_mesh        (mesh),
   m_acc_mem_adv (acc_mem_adv),
   m_runner      (runner)
@@ -47,14 +49,23 @@ VarSyncMng::VarSyncMng(IMesh* mesh, ax::Runner& runner, AccMemAdviser* acc_mem_a
   m_ref_queue_bnd  = AcceleratorUtils::refQueueAsync(m_runner, QP_high);
   m_ref_queue_data = AcceleratorUtils::refQueueAsync(m_runner, QP_high);
 
-  // Pour synchro algo1
-  m_vsync_algo1 = new VarSyncAlgo1(m_pm, m_neigh_ranks);
+  // Pour synchro algo1, les patterns de comms persistantes sont enregistrés
+  // au premier appel puis redémarrés à chaque synchronisation
+  m_vsync_algo1 = new VarSyncAlgo1(m_pm, m_neigh_ranks, use_persistent_comm);
+  // Le thread de progression des comms n'utilise que des requêtes persistantes,
+  // avec un tag propre pour ne pas intercepter les messages de m_vsync_algo1
+  m_thr_vsync_algo1 = new VarSyncAlgo1(m_pm, m_neigh_ranks, /*use_persistent=*/true, 
+      /*persistent_tag=*/1011);
 }
 
 VarSyncMng::~VarSyncMng() {
+  delete m_comm_thread;  // attend la fin du thread avant de libérer ses buffers
+  delete m_thr_sync_buffers;
   delete m_sync_cells;
   delete m_sync_nodes;
+  delete m_sync_faces;
   delete m_sync_buffers;
+  delete m_split_sync_buffers;
   delete m_neigh_queues;
 
   delete m_sync_evi;
@@ -62,6 +73,7 @@ VarSyncMng::~VarSyncMng() {
   delete m_buf_addr_mng;
 
   delete m_vsync_algo1;
+  delete m_thr_vsync_algo1;
   delete m_a1_mmat_dh_pi;
   delete m_a1_mmat_d_pi;
 }
@@ -99,6 +111,9 @@ void VarSyncMng::updateSyncMultiEnv() {
   if (m_sync_evi) {
     m_sync_evi->updateEnvIndexes();
   }
+  // Les patterns de comms persistantes sont conservés : ils sont identifiés
+  // par les adresses et tailles des buffers, des messages multi-mat de
+  // tailles différentes trouvent ou enregistrent leur propre pattern
 }
 
 /*---------------------------------------------------------------------------*/
@@ -141,6 +156,72 @@ SyncItems<Node>* VarSyncMng::getSyncItems() {
   return m_sync_nodes;
 }
 
+template<>
+SyncItems<Face>* VarSyncMng::getSyncItems() {
+  if (!isFaceSyncAvailable()) {
+    throw NotSupportedException(A_FUNCINFO, "Face neighbours are not all cell neighbours, use synchronize()");
+  }
+  if (!m_sync_faces) {
+    m_sync_faces = new SyncItems<Face>(m_mesh,m_neigh_ranks, m_acc_mem_adv);
+  }
+  return m_sync_faces;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Retourne vrai si les faces peuvent être synchronisées avec les voisins    */
+/* des mailles (les messages sont construits pour m_neigh_ranks)             */
+/* Appel collectif la première fois                                          */
+/*---------------------------------------------------------------------------*/
+bool VarSyncMng::isFaceSyncAvailable() {
+  if (m_face_sync_status==0) {
+    // Déterminé une seule fois : en 3D, une face fantôme peut appartenir à
+    // un sous-domaine qui n'a aucune maille en commun avec celui-ci
+    Int32ConstArrayView face_ranks =
+      m_mesh->faceFamily()->allItemsSynchronizer()->communicatingRanks();
+    Integer face_sync_status = 1;
+    for(Int32 face_rank : face_ranks) {
+      if (!m_neigh_ranks.contains(face_rank)) {
+        face_sync_status = -1;
+        break;
+      }
+    }
+    // Tous les sous-domaines doivent faire le même choix (messages regroupés
+    // ou synchronize() d'Arcane), sinon les échanges ne se correspondent pas
+    m_face_sync_status = m_pm->reduce(Parallel::ReduceMin, face_sync_status);
+  }
+  return (m_face_sync_status > 0);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Exception si vars contient des variables multi-mat : les synchronisations */
+/* de variables globales ne les traitent pas                                 */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::_checkGlobalVarsOnly(MeshVariableSynchronizerList& vars) const {
+  if (vars.varsList().size()>0) {
+    throw FatalErrorException(A_FUNCINFO, "La liste contient des variables multi-mat, utiliser multiMatSynchronize");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Si vars contient une variable aux faces qui ne peut pas passer par les    */
+/* messages regroupés, synchronise chaque variable avec Arcane et retourne   */
+/* vrai                                                                      */
+/*---------------------------------------------------------------------------*/
+bool VarSyncMng::_synchronizeByVariable(MeshVariableSynchronizerList& vars) {
+  auto lvars = vars.globalVarsList();
+  bool has_face_var = false;
+  for(IGlobalVarSync* var : lvars) {
+    has_face_var = has_face_var || (var->itemKind()==IK_Face);
+  }
+  if (!has_face_var || isFaceSyncAvailable()) {
+    return false;
+  }
+  for(IGlobalVarSync* var : lvars) {
+    var->synchronize();
+  }
+  return true;
+}
+
 /*---------------------------------------------------------------------------*/
 /* Effectue une première allocation des buffers pour les communications      */
 /* Ceci est une pré-allocation pour miniser le nb de réallocations           */
@@ -168,6 +249,12 @@ void VarSyncMng::_preAllocBuffers() {
 void VarSyncMng::multiMatSynchronize(MeshVariableSynchronizerList& vars, 
     Ref<RunQueue> ref_queue, eVarSyncVersion vs_version)
 {
+  _checkNoThreadSync();
+
+  if (vars.globalVarsList().size()>0) {
+    throw FatalErrorException(A_FUNCINFO, "La liste contient des variables globales, utiliser globalSynchronize");
+  }
+
   IAlgo1SyncData* sync_data=nullptr;
   if (vs_version==VS_bulksync_evqueue) 
   {
@@ -186,3 +273,55 @@ void VarSyncMng::multiMatSynchronize(MeshVariableSynchronizerList& vars,
   delete sync_data;
 }
 
+/*---------------------------------------------------------------------------*/
+/* Par variable globale de vars, les items à envoyer/recevoir par voisin     */
+/* en fonction du type d'item de la variable                                 */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::_globalItemIdxPv(MeshVariableSynchronizerList& vars,
+    Array<ConstMultiArray2View<Integer>>& owned_item_idx_pv,
+    Array<ConstMultiArray2View<Integer>>& ghost_item_idx_pv)
+{
+  auto lvars = vars.globalVarsList();
+  Integer nb_var = lvars.size();
+
+  owned_item_idx_pv.resize(nb_var);
+  ghost_item_idx_pv.resize(nb_var);
+  for(Integer ivar=0 ; ivar<nb_var ; ++ivar) {
+    eItemKind item_kind = lvars[ivar]->itemKind();
+    if (item_kind==IK_Cell) {
+      owned_item_idx_pv[ivar] = getSyncItems<Cell>()->ownedItemIdxPn();
+      ghost_item_idx_pv[ivar] = getSyncItems<Cell>()->ghostItemIdxPn();
+    } else if (item_kind==IK_Node) {
+      owned_item_idx_pv[ivar] = getSyncItems<Node>()->ownedItemIdxPn();
+      ghost_item_idx_pv[ivar] = getSyncItems<Node>()->ghostItemIdxPn();
+    } else if (item_kind==IK_Face) {
+      owned_item_idx_pv[ivar] = getSyncItems<Face>()->ownedItemIdxPn();
+      ghost_item_idx_pv[ivar] = getSyncItems<Face>()->ghostItemIdxPn();
+    } else {
+      throw NotSupportedException(A_FUNCINFO, 
+          String::format("Invalid item kind for this method ={0}",(int)item_kind));
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Maj des items fantômes d'une liste de variables globales                  */
+/* Toutes les variables sont regroupées dans un seul message par voisin      */
+/*---------------------------------------------------------------------------*/
+void VarSyncMng::globalSynchronize(MeshVariableSynchronizerList& vars)
+{
+  _checkNoThreadSync();
+  _checkGlobalVarsOnly(vars);
+
+  if (_synchronizeByVariable(vars)) {
+    return;
+  }
+
+  // Pour chaque variable, les items à envoyer/recevoir dépendent de son type d'item
+  UniqueArray<ConstMultiArray2View<Integer>> owned_item_idx_pv;
+  UniqueArray<ConstMultiArray2View<Integer>> ghost_item_idx_pv;
+  _globalItemIdxPv(vars, owned_item_idx_pv, ghost_item_idx_pv);
+
+  Algo1SyncDataGlobal sync_data(vars, owned_item_idx_pv, ghost_item_idx_pv, m_sync_buffers);
+  m_vsync_algo1->synchronize(&sync_data);
+}
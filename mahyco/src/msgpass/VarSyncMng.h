@@ -17,6 +17,8 @@
 #include "msgpass/VarSyncAlgo1.h"
 #include "msgpass/Algo1SyncDataMMatDH.h"
 #include "msgpass/Algo1SyncDataMMatD.h"
+#include "msgpass/Algo1SyncDataGlobal.h"
+#include "msgpass/CommProgressThread.h"
 
 using namespace Arcane;
 using namespace Arcane::Materials;
@@ -59,12 +61,42 @@ class GlobalSyncRequest {
   MeshVarRefT<ItemType, DataType> m_var;  //! variable Arcane dont il faut mettre les items fantômes à jour
 };
 
+/*---------------------------------------------------------------------------*/
+/* Encapsule une synchronisation en deux temps (beginSync/endSync)           */
+/* d'une liste de variables globales                                         */
+/*---------------------------------------------------------------------------*/
+class GlobalSyncListRequest {
+ public:
+  GlobalSyncListRequest(
+    VarSyncAlgo1* vsync_algo1,
+    MeshVariableSynchronizerList& vars,
+    ConstArrayView<ConstMultiArray2View<Integer>> owned_item_idx_pv,
+    ConstArrayView<ConstMultiArray2View<Integer>> ghost_item_idx_pv,
+    SyncBuffers* sync_buffers,
+    bool* is_pending);
+
+  virtual ~GlobalSyncListRequest();
+
+  // Termine les comms et met à jour les items fantômes des variables
+  void wait();
+
+ protected:
+  bool m_is_over=false;  //! Indique si la requête est terminée
+  VarSyncAlgo1* m_vsync_algo1=nullptr;  //! Algo qui a amorcé les comms
+  UniqueArray<ConstMultiArray2View<Integer>> m_owned_item_idx_pv;  //! par variable, items à envoyer par voisin
+  UniqueArray<ConstMultiArray2View<Integer>> m_ghost_item_idx_pv;  //! par variable, items fantômes par voisin
+  Algo1SyncDataGlobal m_sync_data;  //! Pack/unpack des variables
+  Algo1SyncRequest m_req;  //! Etat des comms en cours
+  bool* m_is_pending=nullptr;  //! Remis à false une fois la requête terminée
+};
+
 /*---------------------------------------------------------------------------*/
 /* Gère les synchronisations des mailles fantômes par Message Passing        */
 /*---------------------------------------------------------------------------*/
 class VarSyncMng {
  public:
-  VarSyncMng(IMesh* mesh, ax::Runner& runner, AccMemAdviser* acc_mem_adv);
+  VarSyncMng(IMesh* mesh, ax::Runner& runner, AccMemAdviser* acc_mem_adv,
+      bool use_persistent_comm=false);
   virtual ~VarSyncMng();
 
   //! Initialise les futures synchros multi-mat
@@ -83,13 +115,50 @@ class VarSyncMng {
   BufAddrMng* bufAddrMng();
 
   // Retourne l'instance de SyncItems<T> en fonction de T
+  // (exception pour Face si !isFaceSyncAvailable())
   template<typename ItemType>
   SyncItems<ItemType>* getSyncItems();
 
+  //! Retourne vrai si tous les voisins des faces sont des voisins des mailles
+  bool isFaceSyncAvailable();
+
   // Equivalent à un var.synchronize() où var est une variable globale (i.e. non multi-mat)
   template<typename MeshVariableRefT>
   void globalSynchronize(MeshVariableRefT var);
 
+  //! Maj des items fantômes d'une liste de variables globales en un seul message par voisin
+  //! (exception si vars contient des variables multi-mat)
+  void globalSynchronize(MeshVariableSynchronizerList& vars);
+
+  /*!
+   * \brief Amorce la maj des items fantômes d'une liste de variables globales :
+   * les valeurs sont envoyées et les réceptions sont en cours au retour.
+   * vars doit rester valide jusqu'à endSync() et les items fantômes 
+   * des variables ne doivent pas être lus avant.
+   * Une seule synchronisation amorcée à la fois.
+   */
+  Ref<GlobalSyncListRequest> beginSync(MeshVariableSynchronizerList& vars);
+
+  //! Termine une synchronisation amorcée par beginSync
+  void endSync(Ref<GlobalSyncListRequest> req);
+
+  //! Retourne vrai si MPI_THREAD_MULTIPLE et les requêtes persistantes sont disponibles
+  bool isCommThreadAvailable() const;
+
+  /*!
+   * \brief Amorce la maj des items fantômes d'une liste de variables globales
+   * sur un thread hôte dédié aux comms (packing, MPI, unpacking sur l'hôte).
+   * Nécessite isCommThreadAvailable().
+   * vars doit rester valide jusqu'à threadSyncWait() (utiliser ThreadSyncGuard),
+   * les items fantômes ne doivent pas être lus avant et aucune autre
+   * synchronisation de ce gestionnaire ne peut avoir lieu entre temps, ni
+   * être en cours à l'appel (beginSync sans endSync) : exception.
+   */
+  void threadSyncBegin(MeshVariableSynchronizerList& vars);
+
+  //! Attend la fin de la synchronisation amorcée par threadSyncBegin
+  void threadSyncWait();
+
   // Equivalent à un globalSynchronize pour lequel les données de var sont sur le DEVice
   // La queue asynchrone ref_queue est synchronisé en fin d'appel
   template<typename MeshVariableRefT>
@@ -126,6 +195,7 @@ class VarSyncMng {
       eVarSyncVersion vs_version=VS_bulksync_evqueue);
 
   //! Maj des mailles fantômes d'une liste de variables multi-mat
+  //! (exception si vars contient des variables globales)
   void multiMatSynchronize(MeshVariableSynchronizerList& vars, Ref<RunQueue> ref_queue, 
       eVarSyncVersion vs_version=VS_bulksync_evqueue);
 
@@ -159,6 +229,20 @@ class VarSyncMng {
   // Pré-allocation des buffers de communication pour miniser le nb de réallocations
   void _preAllocBuffers();
 
+  // Exception si une synchronisation amorcée par threadSyncBegin est en cours
+  void _checkNoThreadSync() const;
+
+  // Exception si vars contient des variables multi-mat
+  void _checkGlobalVarsOnly(MeshVariableSynchronizerList& vars) const;
+
+  // Synchronise chaque variable de vars avec Arcane si les faces l'imposent
+  bool _synchronizeByVariable(MeshVariableSynchronizerList& vars);
+
+  // Par variable globale de vars, les items à envoyer/recevoir par voisin
+  void _globalItemIdxPv(MeshVariableSynchronizerList& vars,
+      Array<ConstMultiArray2View<Integer>>& owned_item_idx_pv,
+      Array<ConstMultiArray2View<Integer>>& ghost_item_idx_pv);
+
  protected:
 
   IMesh* m_mesh=nullptr;
@@ -176,8 +260,17 @@ class VarSyncMng {
 
   SyncItems<Cell>* m_sync_cells=nullptr;
   SyncItems<Node>* m_sync_nodes=nullptr;
+  SyncItems<Face>* m_sync_faces=nullptr;  //! Créé au premier besoin
+  Integer m_face_sync_status=0;  //! 0 : pas encore déterminé, 1 : faces synchronisables, -1 : non
 
   SyncBuffers* m_sync_buffers=nullptr;
+  SyncBuffers* m_split_sync_buffers=nullptr;  //! Buffers propres à beginSync/endSync, créés au premier besoin
+  bool m_is_split_sync_pending=false;  //! Vrai entre beginSync et endSync
+
+  CommProgressThread* m_comm_thread=nullptr;  //! Thread de progression des comms, créé au premier besoin
+  SyncBuffers* m_thr_sync_buffers=nullptr;  //! Buffers utilisés par m_comm_thread, créés par lui
+  VarSyncAlgo1* m_thr_vsync_algo1=nullptr;  //! Algo (requêtes persistantes) propre à m_comm_thread
+  Int64 m_nb_thread_sync=0;  //! Nb de synchronisations confiées à m_comm_thread
 
   MultiAsyncRunQueue* m_neigh_queues=nullptr;  //! Pour gérer plusieurs queues pour les voisins
 
@@ -197,6 +290,45 @@ class VarSyncMng {
   Algo1SyncDataMMatD::PersistentInfo* m_a1_mmat_d_pi=nullptr;
 };
 
+/*---------------------------------------------------------------------------*/
+/* \class ThreadSyncGuard                                                    */
+/* \brief Amorce threadSyncBegin à la construction et garantit qu'à la       */
+/*   destruction le thread de progression n'utilise plus vars, même si une   */
+/*   exception interrompt le calcul : à déclarer après vars                  */
+/*---------------------------------------------------------------------------*/
+class ThreadSyncGuard {
+ public:
+  ThreadSyncGuard(VarSyncMng* vsync_mng, MeshVariableSynchronizerList& vars) :
+    m_vsync_mng (vsync_mng)
+  {
+    m_vsync_mng->threadSyncBegin(vars);
+    m_is_pending = true;
+  }
+
+  ThreadSyncGuard(const ThreadSyncGuard&) = delete;
+  ThreadSyncGuard& operator=(const ThreadSyncGuard&) = delete;
+
+  ~ThreadSyncGuard() {
+    if (m_is_pending) {
+      // Une exception est déjà en cours : celle du thread n'est pas propagée
+      try {
+        m_vsync_mng->threadSyncWait();
+      } catch (...) {
+      }
+    }
+  }
+
+  //! Attend la fin de la synchronisation, propage l'exception du thread
+  void wait() {
+    m_is_pending = false;
+    m_vsync_mng->threadSyncWait();
+  }
+
+ protected:
+  VarSyncMng* m_vsync_mng=nullptr;
+  bool m_is_pending=false;  //! Vrai tant que wait() n'a pas été appelé
+};
+
 // Implementation template de computeAndSync
 #include "msgpass/ComputeAndSync.h"
 #include "msgpass/ComputeMatAndSync.h"
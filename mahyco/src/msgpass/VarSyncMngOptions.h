@@ -11,7 +11,8 @@ enum eVarSyncVersion {
   VS_bulksync_evqueue_d, // Idem que VS_bulksync_evqueue mais comms avec adresses DEVICE (GPU-aware)
   VS_overlap_evqueue, // Recouvrement items shared+packing/unpacking GPU+comms (en utilisant des events) par calculs itemss private
   VS_overlap_evqueue_d, // Idem que VS_overlap_evqueue mais comms avec adresses DEVICE (GPU-aware)
-  VS_overlap_iqueue // Recouvrement : traitements shared et private concurrents et asynchrones + iGlobalSynchronizeQueue
+  VS_overlap_iqueue, // Recouvrement : traitements shared et private concurrents et asynchrones + iGlobalSynchronizeQueue
+  VS_overlap_thread // Recouvrement sur CPU : pack+comms+unpack par un thread hôte dédié pendant le calcul des items private
 };
 
 #endif
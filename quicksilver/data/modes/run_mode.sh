@@ -0,0 +1,72 @@
+#!/bin/sh
+#
+# Génère un cas à partir de Base.arc (titre et fichier csv nommés <nom>, puis
+# expressions sed appliquées aux marqueurs MODE_*), le lance, et selon <test> :
+#   counters : lance aussi Base.arc et vérifie que les compteurs de particules
+#              (m_start, m_source, ..., m_end) de chaque itération sont
+#              identiques ;
+#   csv      : idem, et vérifie que le fichier ./csv/<nom>.csv est écrit ;
+#   run      : lance seulement le cas (autre suite aléatoire par exemple).
+#
+# Usage : run_mode.sh <exécutable Quicksilver> <nom> <counters|csv|run> [expression sed]...
+#   QS_LAUNCHER : lanceur MPI (ex : "mpirun -n 4", le maillage a 4 parties)
+#   QS_ARGS     : arguments supplémentaires (ex : "-A,T=4")
+#
+QS_EXE=$1
+MODE=$2
+CHECK=$3
+MODES_DIR=$(cd "$(dirname "$0")" && pwd)
+
+if [ $# -lt 3 ]; then
+  echo "Usage : $0 <exécutable Quicksilver> <nom> <counters|csv|run> [expression sed]..."
+  exit 2
+fi
+shift 3
+
+mkdir -p csv
+
+sed "s|@MODE@|${MODE}|g" "${MODES_DIR}/Base.arc" > "${MODE}.arc" || exit 1
+for expr in "$@"; do
+  sed "${expr}" "${MODE}.arc" > "${MODE}.arc.tmp" && mv "${MODE}.arc.tmp" "${MODE}.arc" || exit 1
+done
+
+run_case() {
+  ${QS_LAUNCHER} "${QS_EXE}" ${QS_ARGS} "$1.arc" > "$1.log" 2>&1
+}
+
+counters() {
+  grep -o '(m_[a-z_]*): [0-9]*' "$1.log"
+}
+
+if ! run_case "${MODE}"; then
+  echo "${MODE} : échec, voir ${MODE}.log"
+  exit 1
+fi
+if [ "${CHECK}" = "run" ]; then
+  exit 0
+fi
+
+if [ "${CHECK}" = "csv" ] && [ ! -s "./csv/${MODE}.csv" ]; then
+  echo "${MODE} : fichier ./csv/${MODE}.csv absent ou vide"
+  exit 1
+fi
+
+BASE="Base_${MODE}"
+sed "s|@MODE@|${BASE}|g" "${MODES_DIR}/Base.arc" > "${BASE}.arc" || exit 1
+if ! run_case "${BASE}"; then
+  echo "${BASE} : échec, voir ${BASE}.log"
+  exit 1
+fi
+
+counters "${BASE}" > "${BASE}.counters"
+counters "${MODE}" > "${MODE}.counters"
+if [ ! -s "${BASE}.counters" ]; then
+  echo "${BASE} : aucun compteur trouvé dans ${BASE}.log"
+  exit 1
+fi
+if ! cmp -s "${BASE}.counters" "${MODE}.counters"; then
+  echo "${MODE} : compteurs différents de ceux de Base.arc"
+  diff "${BASE}.counters" "${MODE}.counters" | head -20
+  exit 1
+fi
+echo "${MODE} : OK"
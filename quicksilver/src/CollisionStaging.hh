@@ -0,0 +1,131 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CollisionStaging.hh                                         (C) 2000-2022 */
+/*                                                                           */
+/* Stockage par thread des produits de collision QAMA                        */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef COLLISIONSTAGING_HH
+#define COLLISIONSTAGING_HH
+
+#include <arcane/Concurrency.h>
+#include <arcane/utils/UniqueArray.h>
+#include <arccore/collections/IMemoryAllocator.h>
+
+using namespace Arcane;
+
+/**
+ * @brief Particule à créer à la fin d'une sous-itération (produit de fission).
+ */
+struct SecondaryParticle
+{
+  Int64 rns; //!< Graine de la future particule (son uniqueId sans le bit de signe).
+  Int32 cell_lid; //!< LocalId de la maille où la créer.
+  Int32 src_lid; //!< LocalId de la particule à cloner.
+  Real energy; //!< Energie pour updateTrajectory.
+  Real angle; //!< Angle pour updateTrajectory.
+};
+
+/**
+ * @brief Particule source d'un split, à mettre à jour avant la sous-itération suivante.
+ */
+struct SplitParticle
+{
+  Int32 local_id;
+  Real energy;
+  Real angle;
+};
+
+/**
+ * @brief Zone de stockage d'un thread.
+ * Les tableaux sont vidés (sans libération) à chaque sous-itération.
+ */
+struct alignas(64) CollisionStaging
+{
+  void clear()
+  {
+    secondaries.clear();
+    sources.clear();
+  }
+
+  UniqueArray<SecondaryParticle> secondaries;
+  UniqueArray<SplitParticle> sources;
+
+  // Tableaux de travail pour sampleCollision() (taille max_production_size).
+  RealUniqueArray energy_out;
+  RealUniqueArray angle_out;
+};
+
+/**
+ * @brief Classe contenant une zone de stockage des produits de collision
+ * par thread. Chaque thread écrit dans sa zone sans verrou, les zones sont
+ * ensuite lues l'une après l'autre par collisionEventSuite().
+ * L'indice 0 est réservé au thread principal hors tâche.
+ */
+class CollisionStagingArena
+{
+ public:
+  /**
+   * @brief Méthode permettant d'allouer les zones.
+   *
+   * @param max_production_size Nombre de particules max généré par une fission.
+   * @param capacity Nombre de produits réservés par thread.
+   */
+  void init(Integer max_production_size, Integer capacity)
+  {
+    m_stagings = UniqueArray<CollisionStaging>(AlignedMemoryAllocator::CacheLine(),
+                                               TaskFactory::nbAllowedThread() + 1);
+    for (CollisionStaging& staging : m_stagings) {
+      staging.secondaries.reserve(capacity);
+      staging.sources.reserve(capacity);
+      staging.energy_out.resize(max_production_size);
+      staging.angle_out.resize(max_production_size);
+    }
+  }
+
+  //! Zone du thread courant.
+  CollisionStaging& local()
+  {
+    return m_stagings[TaskFactory::currentTaskThreadIndex() + 1];
+  }
+
+  ArrayView<CollisionStaging> stagings() { return m_stagings; }
+
+  Integer nbSecondaries() const
+  {
+    Integer nb_secondaries = 0;
+    for (const CollisionStaging& staging : m_stagings) {
+      nb_secondaries += staging.secondaries.size();
+    }
+    return nb_secondaries;
+  }
+
+  //! Vrai si aucun thread n'a de produit de collision en attente.
+  bool empty() const
+  {
+    for (const CollisionStaging& staging : m_stagings) {
+      if (!staging.secondaries.empty() || !staging.sources.empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void clear()
+  {
+    for (CollisionStaging& staging : m_stagings) {
+      staging.clear();
+    }
+  }
+
+ private:
+  UniqueArray<CollisionStaging> m_stagings;
+};
+
+#endif
@@ -0,0 +1,121 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CrossSectionTable.cc                                        (C) 2000-2022 */
+/*                                                                           */
+/* Tables des sections efficaces par matériau QAMA                           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "CrossSectionTable.hh"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Méthode permettant de construire les tables de tous les matériaux.
+ *
+ * @param nuclear_data Les données nucléaires (isotopes déjà ajoutés).
+ * @param nb_group Le nombre de groupes d'énergie.
+ * @param material_isotopes Les gid des isotopes de chaque matériau.
+ * @param material_atom_fractions Les fractions atomiques des isotopes de chaque matériau.
+ */
+void CrossSectionTable::
+build(NuclearData* nuclear_data, Integer nb_group,
+      ConstArrayView<Int32UniqueArray> material_isotopes,
+      ConstArrayView<RealUniqueArray> material_atom_fractions)
+{
+  // Nombre de Real dans une ligne de cache.
+  const Integer nb_real_per_line = 64 / sizeof(Real);
+
+  const Integer nb_material = material_isotopes.size();
+
+  m_nb_group = nb_group;
+  m_nb_entry.resize(nb_material);
+  m_row_stride.resize(nb_material);
+  m_material_offset.resize(nb_material);
+  m_entry_isotope.resize(nb_material);
+  m_entry_reaction.resize(nb_material);
+
+  m_isotope_offset.resize(nb_material + 1);
+  m_isotope_gid.clear();
+  m_isotope_atom_fraction.clear();
+  m_isotope_offset[0] = 0;
+  for (Integer material = 0; material < nb_material; material++) {
+    m_isotope_gid.addRange(material_isotopes[material]);
+    m_isotope_atom_fraction.addRange(material_atom_fractions[material]);
+    m_isotope_offset[material + 1] = m_isotope_gid.size();
+  }
+
+  Int64 cdf_size = 0;
+
+  for (Integer material = 0; material < nb_material; material++) {
+    Int32UniqueArray& entry_isotope = m_entry_isotope[material];
+    Int32UniqueArray& entry_reaction = m_entry_reaction[material];
+    entry_isotope.clear();
+    entry_reaction.clear();
+
+    for (Integer isotope_gid : isotopes(material)) {
+      Integer nb_reaction = nuclear_data->getNumberReactions(isotope_gid);
+      for (Integer reaction = 0; reaction < nb_reaction; reaction++) {
+        entry_isotope.add(isotope_gid);
+        entry_reaction.add(reaction);
+      }
+    }
+
+    const Integer nb_entry = entry_isotope.size();
+    m_nb_entry[material] = nb_entry;
+    m_row_stride[material] = ((nb_entry + nb_real_per_line - 1) / nb_real_per_line) * nb_real_per_line;
+    m_material_offset[material] = cdf_size;
+    cdf_size += static_cast<Int64>(m_row_stride[material]) * nb_group;
+  }
+
+  m_cdf.resize(cdf_size);
+  m_cdf.fill(1.0);
+  m_total.resize(static_cast<Int64>(nb_material) * nb_group);
+
+  for (Integer material = 0; material < nb_material; material++) {
+    ConstArrayView<Int32> isotope_gids = isotopes(material);
+    ConstArrayView<Real> atom_fractions = atomFractions(material);
+    const Integer nb_entry = m_nb_entry[material];
+
+    for (Integer group = 0; group < nb_group; group++) {
+      Real* row = m_cdf.data() + m_material_offset[material] + static_cast<Int64>(group) * m_row_stride[material];
+
+      Real sum = 0.0;
+      Real total = 0.0;
+      Integer entry = 0;
+      for (Integer iso_index = 0; iso_index < isotope_gids.size(); iso_index++) {
+        Integer nb_reaction = nuclear_data->getNumberReactions(isotope_gids[iso_index]);
+        for (Integer reaction = 0; reaction < nb_reaction; reaction++) {
+          sum += atom_fractions[iso_index] * nuclear_data->getReactionCrossSection(reaction, isotope_gids[iso_index], group);
+          row[entry++] = sum;
+        }
+        // Un isotope absent ne contribue pas à la section efficace totale.
+        if (atom_fractions[iso_index] != 0.0) {
+          total += atom_fractions[iso_index] * nuclear_data->getTotalCrossSection(isotope_gids[iso_index], group);
+        }
+      }
+      m_total[static_cast<Int64>(material) * nb_group + group] = total;
+
+      if (sum > 0.0) {
+        const Real inv_sum = 1.0 / sum;
+        for (Integer i = 0; i < nb_entry; i++) {
+          row[i] *= inv_sum;
+        }
+      }
+      // La dernière valeur doit valoir exactement 1 pour que le tirage
+      // trouve toujours une entrée.
+      if (nb_entry > 0) {
+        row[nb_entry - 1] = 1.0;
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,115 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CrossSectionTable.hh                                        (C) 2000-2022 */
+/*                                                                           */
+/* Tables des sections efficaces par matériau QAMA                           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef CROSSSECTIONTABLE_HH
+#define CROSSSECTIONTABLE_HH
+
+#include "NuclearData.hh"
+#include <arcane/utils/UniqueArray.h>
+#include <arccore/collections/IMemoryAllocator.h>
+
+using namespace Arcane;
+
+/**
+ * @brief Classe contenant les données en lecture seule de chaque matériau.
+ *
+ * Les isotopes des matériaux sont stockés une seule fois par matériau, dans
+ * deux tableaux contigus (gid et fraction atomique) indexés par
+ * m_isotope_offset : les mailles n'ont besoin que de leur indice de
+ * matériau (m_cell_material_index dans TrackingMC).
+ *
+ * Pour chaque matériau et chaque groupe d'énergie, la classe contient la
+ * fonction de répartition (normalisée) des couples (isotope, réaction).
+ *
+ * Pour un matériau, la ligne d'un groupe contient nb_entry valeurs
+ * croissantes, la dernière valant 1. L'entrée k correspond à l'isotope
+ * entryIsotope(material, k) et à la réaction entryReaction(material, k).
+ * Les lignes sont complétées pour faire un multiple d'une ligne de cache et
+ * le tableau est aligné sur une ligne de cache.
+ *
+ * Le tirage d'une réaction se fait donc par une recherche dichotomique
+ * dans une seule ligne contiguë.
+ *
+ * La classe contient aussi, pour chaque matériau et chaque groupe, la
+ * section efficace totale pondérée par les fractions atomiques (sans la
+ * densité de la maille, qui est appliquée à l'utilisation). Ces valeurs ne
+ * dépendent que des matériaux et des données nucléaires : elles ne sont
+ * recalculées que lors d'un nouvel appel à build().
+ */
+class CrossSectionTable
+{
+ public:
+  void build(NuclearData* nuclear_data, Integer nb_group,
+             ConstArrayView<Int32UniqueArray> material_isotopes,
+             ConstArrayView<RealUniqueArray> material_atom_fractions);
+
+  /**
+   * @brief Méthode permettant de choisir une entrée de la table.
+   *
+   * @param material L'indice du matériau.
+   * @param group Le groupe d'énergie.
+   * @param random_number Un nombre aléatoire dans [0, 1[.
+   * @return Integer L'indice de l'entrée choisie.
+   */
+  Integer sample(Integer material, Integer group, Real random_number) const
+  {
+    group = std::min(group, m_nb_group - 1);
+    const Integer nb_entry = m_nb_entry[material];
+    const Real* row = m_cdf.data() + m_material_offset[material] + static_cast<Int64>(group) * m_row_stride[material];
+    const Integer entry = static_cast<Integer>(std::upper_bound(row, row + nb_entry, random_number) - row);
+    return std::min(entry, nb_entry - 1);
+  }
+
+  /**
+   * @brief Méthode permettant de récupérer la section efficace totale
+   * d'un matériau (somme sur ses isotopes de atom_fraction * section microscopique).
+   *
+   * @param material L'indice du matériau.
+   * @param group Le groupe d'énergie.
+   * @return Real La section efficace, à multiplier par la densité de la maille.
+   */
+  Real total(Integer material, Integer group) const
+  {
+    return m_total[static_cast<Int64>(material) * m_nb_group + group];
+  }
+
+  //! Gid des isotopes du matériau.
+  ConstArrayView<Int32> isotopes(Integer material) const
+  {
+    return m_isotope_gid.subConstView(m_isotope_offset[material], m_isotope_offset[material + 1] - m_isotope_offset[material]);
+  }
+
+  //! Fractions atomiques des isotopes du matériau (même ordre que isotopes()).
+  ConstArrayView<Real> atomFractions(Integer material) const
+  {
+    return m_isotope_atom_fraction.subConstView(m_isotope_offset[material], m_isotope_offset[material + 1] - m_isotope_offset[material]);
+  }
+
+  Integer entryIsotope(Integer material, Integer entry) const { return m_entry_isotope[material][entry]; }
+  Integer entryReaction(Integer material, Integer entry) const { return m_entry_reaction[material][entry]; }
+
+ private:
+  Integer m_nb_group = 0;
+  Int32UniqueArray m_isotope_offset;
+  Int32UniqueArray m_isotope_gid;
+  RealUniqueArray m_isotope_atom_fraction;
+  Int32UniqueArray m_nb_entry;
+  Int32UniqueArray m_row_stride;
+  Int64UniqueArray m_material_offset;
+  UniqueArray<Int32UniqueArray> m_entry_isotope;
+  UniqueArray<Int32UniqueArray> m_entry_reaction;
+  RealUniqueArray m_cdf{ AlignedMemoryAllocator::CacheLine() };
+  RealUniqueArray m_total;
+};
+
+#endif
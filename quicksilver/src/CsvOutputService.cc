@@ -12,6 +12,9 @@
 /*---------------------------------------------------------------------------*/
 
 #include "CsvOutputService.hh"
+#include <arcane/IParallelMng.h>
+#include <algorithm>
+#include <cstdio>
 using namespace Arcane;
 
 void CsvOutputService::
@@ -23,9 +26,35 @@ init(String name_csv, String separator_csv)
   size_columns.add(1);
 }
 
+bool CsvOutputService::
+initStream(String path_file, Integer flush_period, bool gather_ranks)
+{
+  if(!path_file.endsWith(".csv")) {
+    error() << "Nom de fichier .csv invalide. Il doit avoir l'extension '.csv'";
+    return false;
+  }
+
+  stream_mode = true;
+  stream_path = path_file;
+  stream_gather = gather_ranks;
+  stream_flush_period = std::max(flush_period, 1);
+  stream_writer = (subDomain()->parallelMng()->commRank() == 0);
+
+  if(stream_writer) {
+    stream_file.open(path_file.localstr());
+    if(!stream_file) {
+      error() << "Impossible d'ouvrir le fichier " << path_file;
+      return false;
+    }
+  }
+  return true;
+}
+
 Integer CsvOutputService::
 addRow(String name_row, bool fill_start)
 {
+  if(stream_mode) return addRowStream(name_row);
+
   name_rows.add(name_row);
   String new_line = name_row + separator;
 
@@ -43,6 +72,12 @@ addRow(String name_row, bool fill_start)
 Integer CsvOutputService::
 addRow(String name_row, ConstArrayView<Real>& elems)
 {
+  if(stream_mode) {
+    Integer pos = addRowStream(name_row);
+    if(pos > 0 && elems.size() > 0) addElemRow(pos, elems[0]);
+    return pos;
+  }
+
   name_rows.add(name_row);
   String new_line = name_row + separator;
 
@@ -71,6 +106,13 @@ addElemsRow(Integer pos, ConstArrayView<Real>& elems)
 bool CsvOutputService::
 addElemRow(Integer pos, Real elem)
 {
+  if(stream_mode) {
+    if(pos < 1 || pos > name_rows.size() || !stream_record_open) return false;
+    stream_values[pos-1] = elem;
+    stream_has_value[pos-1] = 1;
+    return true;
+  }
+
   if(pos >= size_columns[0]) {
     error() << "Mauvaise pos";
     return false;
@@ -94,6 +136,8 @@ addElemRow(String name_row, Real elem, bool create_if_not_exist)
 Integer CsvOutputService::
 addColumn(String name_column, bool fill_start)
 {
+  if(stream_mode) return addColumnStream(name_column);
+
   name_columns.add(name_column);
   String new_column = name_column + separator;
 
@@ -106,6 +150,14 @@ addColumn(String name_column, bool fill_start)
 Integer CsvOutputService::
 addColumn(String name_column, ConstArrayView<Real>& elems)
 {
+  if(stream_mode) {
+    Integer pos = addColumnStream(name_column);
+    for(Integer i = 0; i < name_rows.size() && i < elems.size(); i++) {
+      addElemRow(i+1, elems[i]);
+    }
+    return pos;
+  }
+
   name_columns.add(name_column);
   String new_column = name_column + separator;
 
@@ -131,6 +183,11 @@ addElemsColumn(Integer pos, ConstArrayView<Real>& elems)
 void CsvOutputService::
 print()
 {
+  if(stream_mode) {
+    info() << "Sortie .csv en mode flux : pas d'écriture dans la sortie standard.";
+    return;
+  }
+
   info() << "Ecriture du .csv dans la sortie standard :";
   for(Integer i = 0; i < rows.size(); i++) {
     std::cout << rows[i] << std::endl;
@@ -141,6 +198,8 @@ print()
 bool CsvOutputService::
 writeFile()
 {
+  if(stream_mode) return closeStream();
+
   if(!path_name.endsWith(".csv")) {
     error() << "Nom de fichier .csv invalide. Il doit avoir l'extension '.csv'";
     return false;
@@ -157,6 +216,9 @@ writeFile()
 bool CsvOutputService::
 writeFile(String path_file)
 {
+  // En mode flux, le fichier est celui donné à initStream().
+  if(stream_mode) return closeStream();
+
   if(!path_file.endsWith(".csv")) {
     error() << "Nom de fichier .csv invalide. Il doit avoir l'extension '.csv'";
     return false;
@@ -168,4 +230,163 @@ writeFile(String path_file)
   }
   ofile.close();
   return true;
-}
\ No newline at end of file
+}
+
+Integer CsvOutputService::
+addRowStream(String name_row)
+{
+  // Une ligne ajoutée après l'écriture de l'entête étend le schéma :
+  // l'entête est réécrite par closeStream().
+  if(stream_header_done && !stream_header_extended) {
+    info() << "Mode flux : nouvelle ligne '" << name_row << "' après l'entête, elle sera ajoutée à l'entête à la fermeture du fichier.";
+    stream_header_extended = true;
+  }
+
+  name_rows.add(name_row);
+  stream_values.add(0.0);
+  stream_has_value.add(0);
+  return name_rows.size();
+}
+
+Integer CsvOutputService::
+addColumnStream(String name_column)
+{
+  endRecordStream();
+
+  stream_record_name = name_column;
+  stream_record_open = true;
+  stream_values.fill(0.0);
+  stream_has_value.fill(0);
+  return size_rows[0]++;
+}
+
+void CsvOutputService::
+endRecordStream()
+{
+  if(!stream_record_open) return;
+  stream_record_open = false;
+
+  // L'entête est écrite avec le premier enregistrement.
+  const bool write_header = !stream_header_done;
+  stream_header_done = true;
+
+  const Integer nb_field = name_rows.size();
+
+  // Les réductions sont faites par tous les sous-domaines, qui doivent
+  // avoir le même schéma (une ligne tardive ajoutée seulement sur certains
+  // sous-domaines donnerait des tableaux de tailles différentes).
+  // Une valeur absente d'un sous-domaine compte pour 0.
+  UniqueArray<Real> min_values;
+  UniqueArray<Real> max_values;
+  UniqueArray<Real> sum_values;
+  if(stream_gather) {
+    IParallelMng* pm = subDomain()->parallelMng();
+    UniqueArray<Integer> nb_fields(2);
+    nb_fields[0] = nb_field;
+    nb_fields[1] = -nb_field;
+    pm->reduce(Parallel::ReduceMax, nb_fields);
+    if(nb_fields[0] != -nb_fields[1]) {
+      ARCANE_FATAL("Mode flux avec csvGatherRanks : nombre de lignes différent selon les sous-domaines ({0} à {1})",
+                   -nb_fields[1], nb_fields[0]);
+    }
+    min_values = stream_values;
+    max_values = stream_values;
+    sum_values = stream_values;
+    pm->reduce(Parallel::ReduceMin, min_values);
+    pm->reduce(Parallel::ReduceMax, max_values);
+    pm->reduce(Parallel::ReduceSum, sum_values);
+    for(Integer i = 0; i < nb_field; i++) {
+      sum_values[i] /= pm->commSize();
+    }
+  }
+
+  if(!stream_writer) return;
+
+  const std::string sep = separator.localstr();
+
+  if(write_header) stream_buffer += streamHeader() + "\n";
+
+  std::string line = stream_record_name.localstr() + sep;
+  for(Integer i = 0; i < nb_field; i++) {
+    if(!stream_has_value[i]) {
+      line += (stream_gather ? sep + sep + sep : sep);
+    }
+    else if(stream_gather) {
+      line += std::string(String::fromNumber(min_values[i]).localstr()) + sep;
+      line += std::string(String::fromNumber(max_values[i]).localstr()) + sep;
+      line += std::string(String::fromNumber(sum_values[i]).localstr()) + sep;
+    }
+    else {
+      line += std::string(String::fromNumber(stream_values[i]).localstr()) + sep;
+    }
+  }
+  stream_buffer += line + "\n";
+
+  if(++stream_nb_pending_records >= stream_flush_period) flushStream();
+}
+
+std::string CsvOutputService::
+streamHeader()
+{
+  const std::string sep = separator.localstr();
+  std::string header = rows[0].localstr();
+  for(Integer i = 0; i < name_rows.size(); i++) {
+    const std::string name = name_rows[i].localstr();
+    if(stream_gather) header += name + " min" + sep + name + " max" + sep + name + " avg" + sep;
+    else              header += name + sep;
+  }
+  return header;
+}
+
+void CsvOutputService::
+flushStream()
+{
+  // On attend la fin de l'écriture précédente avant de lancer la suivante,
+  // le calcul continue pendant l'écriture.
+  if(stream_flush.valid()) stream_flush.get();
+  stream_nb_pending_records = 0;
+  if(stream_buffer.empty()) return;
+
+  stream_flush = std::async(std::launch::async, [this, data = std::move(stream_buffer)]() {
+    stream_file << data;
+    stream_file.flush();
+  });
+  stream_buffer.clear();
+}
+
+bool CsvOutputService::
+closeStream()
+{
+  endRecordStream();
+  stream_mode = false;
+
+  if(!stream_writer) return true;
+
+  flushStream();
+  if(stream_flush.valid()) stream_flush.get();
+
+  bool is_good = stream_file.good();
+  stream_file.close();
+
+  // Des lignes ont été ajoutées après l'entête : on la remplace par
+  // l'entête complète (les enregistrements plus anciens ont juste moins
+  // de champs). Le fichier est recopié ligne par ligne dans un fichier
+  // temporaire pour ne pas le charger en mémoire.
+  if(is_good && stream_header_extended) {
+    const std::string path = stream_path.localstr();
+    const std::string tmp_path = path + ".tmp";
+    std::ifstream ifile(path);
+    std::ofstream ofile(tmp_path, std::ios::trunc);
+    std::string line;
+    std::getline(ifile, line);
+    ofile << streamHeader() << "\n";
+    while(std::getline(ifile, line)) {
+      ofile << line << "\n";
+    }
+    is_good = ofile.good();
+    ifile.close();
+    ofile.close();
+    is_good = is_good && (std::rename(tmp_path.c_str(), path.c_str()) == 0);
+  }
+  return is_good;
+}
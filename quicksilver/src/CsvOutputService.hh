@@ -17,6 +17,10 @@
 #include "ISimpleOutput.hh"
 #include "CsvOutput_axl.h"
 
+#include <fstream>
+#include <future>
+#include <string>
+
 using namespace Arcane;
 
 class CsvOutputService
@@ -39,10 +43,14 @@ public:
       }
     }
   
-  virtual ~CsvOutputService() {};
+  virtual ~CsvOutputService()
+  {
+    if(stream_flush.valid()) stream_flush.wait();
+  };
 
 public:
   virtual void init(String name_csv, String separator);
+  virtual bool initStream(String path_file, Integer flush_period, bool gather_ranks);
 
   virtual Integer addRow(String name_row, bool fill_start);
   virtual Integer addRow(String name_row, ConstArrayView<Real>& elems);
@@ -63,6 +71,13 @@ private:
   bool addElemsRow(Integer pos, ConstArrayView<Real>& elems);
   bool addElemsColumn(Integer pos, ConstArrayView<Real>& elems);
 
+  Integer addRowStream(String name_row);
+  Integer addColumnStream(String name_column);
+  void endRecordStream();
+  std::string streamHeader();
+  void flushStream();
+  bool closeStream();
+
 private:
   UniqueArray<String> rows;
 
@@ -75,6 +90,29 @@ private:
   String separator;
 
   String path_name;
+
+  // Mode flux : les noms des lignes (name_rows) deviennent les champs d'un
+  // enregistrement. L'entête est écrite à la fin du premier enregistrement ;
+  // une ligne ajoutée ensuite est un nouveau champ des enregistrements
+  // suivants et l'entête est réécrite par closeStream().
+  // Seul le sous-domaine 0 écrit le fichier.
+  bool stream_mode = false;
+  bool stream_gather = false;
+  bool stream_writer = false;
+  bool stream_header_done = false;
+  bool stream_header_extended = false;
+  bool stream_record_open = false;
+  Integer stream_flush_period = 1;
+  Integer stream_nb_pending_records = 0;
+
+  String stream_path;
+  String stream_record_name;
+  UniqueArray<Real> stream_values;
+  UniqueArray<Integer> stream_has_value;
+
+  std::string stream_buffer;
+  std::ofstream stream_file;
+  std::future<void> stream_flush;
 };
 
 #endif
@@ -0,0 +1,264 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* FacetBench.cc                                               (C) 2000-2022 */
+/*                                                                           */
+/* Microbenchmark de la recherche de facet QAMA                              */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "FacetGeometry.hh"
+#include "PhysicalConstants.hh"
+#include <arcane/utils/MathUtils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Compare, sur un maillage cartésien n*n*n de mailles unités, la recherche
+ * de la facet la plus proche :
+ * - legacy : calcul face par face à partir des nodes (comme
+ *   TrackingMCModule::getNearestFacet() sans géométrie précalculée),
+ * - packed : FacetGeometry::computeDistances().
+ *
+ * Usage : QSFacetBench [nb_cell_per_dir] [nb_particle]
+ */
+
+namespace
+{
+// Nodes de chaque face d'un hexaèdre (numérotation locale x, puis y, puis z).
+const Integer face_nodes[6][4] = {
+  { 0, 4, 6, 2 }, // -X
+  { 1, 3, 7, 5 }, // +X
+  { 0, 1, 5, 4 }, // -Y
+  { 2, 6, 7, 3 }, // +Y
+  { 0, 2, 3, 1 }, // -Z
+  { 4, 5, 7, 6 } // +Z
+};
+
+const Real3 face_normals[6] = {
+  Real3(-1, 0, 0), Real3(1, 0, 0),
+  Real3(0, -1, 0), Real3(0, 1, 0),
+  Real3(0, 0, -1), Real3(0, 0, 1)
+};
+
+Integer
+nearestPositive(const Real* distance)
+{
+  Integer nearest = -1;
+  Real nearest_distance = PhysicalConstants::_hugeDouble;
+  for (Integer facet = 0; facet < FacetGeometry::NB_FACET; facet++) {
+    if (distance[facet] >= 0.0 && distance[facet] < nearest_distance) {
+      nearest_distance = distance[facet];
+      nearest = facet;
+    }
+  }
+  return nearest;
+}
+
+struct BenchMesh
+{
+  UniqueArray<Real3> node_coord;
+  UniqueArray<Int32> cell_nodes;
+  UniqueArray<Real3> face_center;
+  FacetGeometry facet_geometry;
+};
+
+/**
+ * @brief Méthode permettant de comparer les deux recherches pour un ensemble
+ * de particules.
+ *
+ * @return Integer Le nombre de particules dont la facet diffère.
+ */
+Integer
+runBench(const char* order, const BenchMesh& mesh,
+         ConstArrayView<Int32> particle_cell,
+         ConstArrayView<Real3> particle_coord,
+         ConstArrayView<Real3> particle_dir_cos)
+{
+  const Integer nb_particle = particle_cell.size();
+
+  UniqueArray<Int32> nearest_legacy(nb_particle);
+  UniqueArray<Int32> nearest_packed(nb_particle);
+
+  // Version legacy.
+  auto legacy_begin = std::chrono::steady_clock::now();
+  for (Integer p = 0; p < nb_particle; p++) {
+    const Int32 cell = particle_cell[p];
+    const Real3 coord = particle_coord[p];
+    const Real3 dir_cos = particle_dir_cos[p];
+    const Real plane_tolerance = 1e-16 * math::dot(coord, coord);
+    Real distance[FacetGeometry::NB_FACET];
+
+    for (Integer face = 0; face < 6; face++) {
+      const Real3 normal = face_normals[face];
+      const Real3 point2 = mesh.face_center[cell * 6 + face];
+      const Real dd = -1.0 * math::dot(normal, point2);
+      const Real facet_normal_dot_direction_cosine = math::dot(normal, dir_cos);
+
+      for (Integer i = 0; i < 4; i++) {
+        if (facet_normal_dot_direction_cosine <= 0.0) {
+          distance[face * 4 + i] = PhysicalConstants::_hugeDouble;
+          continue;
+        }
+        const Real3 point0 = mesh.node_coord[mesh.cell_nodes[cell * 8 + face_nodes[face][i]]];
+        const Real3 point1 = mesh.node_coord[mesh.cell_nodes[cell * 8 + face_nodes[face][(i + 1) % 4]]];
+        distance[face * 4 + i] = FacetGeometry::distanceToSegmentFacet(
+        plane_tolerance, facet_normal_dot_direction_cosine,
+        normal.x, normal.y, normal.z, dd,
+        point2, point0, point1, coord, dir_cos, false);
+      }
+    }
+    nearest_legacy[p] = nearestPositive(distance);
+  }
+  auto legacy_end = std::chrono::steady_clock::now();
+
+  // Version packed.
+  auto packed_begin = std::chrono::steady_clock::now();
+  for (Integer p = 0; p < nb_particle; p++) {
+    const Real3 coord = particle_coord[p];
+    const Real plane_tolerance = 1e-16 * math::dot(coord, coord);
+    Real distance[FacetGeometry::NB_FACET];
+    mesh.facet_geometry.computeDistances(particle_cell[p], plane_tolerance, coord, particle_dir_cos[p], distance);
+    nearest_packed[p] = nearestPositive(distance);
+  }
+  auto packed_end = std::chrono::steady_clock::now();
+
+  Integer nb_mismatch = 0;
+  for (Integer p = 0; p < nb_particle; p++) {
+    if (nearest_legacy[p] != nearest_packed[p]) {
+      nb_mismatch++;
+    }
+  }
+
+  const Real legacy_time = std::chrono::duration<Real>(legacy_end - legacy_begin).count();
+  const Real packed_time = std::chrono::duration<Real>(packed_end - packed_begin).count();
+
+  std::cout << "Order     : " << order << "\n"
+            << "Legacy    : " << legacy_time << " s (" << (legacy_time * 1e9 / nb_particle) << " ns/particle)\n"
+            << "Packed    : " << packed_time << " s (" << (packed_time * 1e9 / nb_particle) << " ns/particle)\n"
+            << "Speedup   : " << (legacy_time / packed_time) << "\n"
+            << "Mismatch  : " << nb_mismatch << "\n";
+
+  return nb_mismatch;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const Integer nb_cell_per_dir = (argc > 1) ? std::atoi(argv[1]) : 16;
+  const Integer nb_particle = (argc > 2) ? std::atoi(argv[2]) : 1000000;
+  const Integer nb_node_per_dir = nb_cell_per_dir + 1;
+  const Integer nb_cell = nb_cell_per_dir * nb_cell_per_dir * nb_cell_per_dir;
+
+  // Maillage.
+  BenchMesh mesh;
+  UniqueArray<Real3>& node_coord = mesh.node_coord;
+  UniqueArray<Int32>& cell_nodes = mesh.cell_nodes;
+  UniqueArray<Real3>& face_center = mesh.face_center;
+  FacetGeometry& facet_geometry = mesh.facet_geometry;
+  node_coord.resize(nb_node_per_dir * nb_node_per_dir * nb_node_per_dir);
+  for (Integer k = 0; k < nb_node_per_dir; k++) {
+    for (Integer j = 0; j < nb_node_per_dir; j++) {
+      for (Integer i = 0; i < nb_node_per_dir; i++) {
+        node_coord[(k * nb_node_per_dir + j) * nb_node_per_dir + i] = Real3(i, j, k);
+      }
+    }
+  }
+
+  cell_nodes.resize(nb_cell * 8);
+  face_center.resize(nb_cell * 6);
+  for (Integer k = 0; k < nb_cell_per_dir; k++) {
+    for (Integer j = 0; j < nb_cell_per_dir; j++) {
+      for (Integer i = 0; i < nb_cell_per_dir; i++) {
+        const Integer cell = (k * nb_cell_per_dir + j) * nb_cell_per_dir + i;
+        for (Integer n = 0; n < 8; n++) {
+          const Integer ni = i + (n & 1), nj = j + ((n >> 1) & 1), nk = k + ((n >> 2) & 1);
+          cell_nodes[cell * 8 + n] = (nk * nb_node_per_dir + nj) * nb_node_per_dir + ni;
+        }
+        for (Integer face = 0; face < 6; face++) {
+          Real3 center;
+          for (Integer n = 0; n < 4; n++) {
+            center += node_coord[cell_nodes[cell * 8 + face_nodes[face][n]]];
+          }
+          face_center[cell * 6 + face] = center / 4.0;
+        }
+      }
+    }
+  }
+
+  facet_geometry.resize(nb_cell);
+  for (Integer cell = 0; cell < nb_cell; cell++) {
+    for (Integer face = 0; face < 6; face++) {
+      const Real3 normal = face_normals[face];
+      const Real3 center = face_center[cell * 6 + face];
+      const Real dd = -1.0 * math::dot(normal, center);
+      for (Integer i = 0; i < 4; i++) {
+        facet_geometry.setFacet(cell, face * 4 + i, normal, dd, center,
+                                node_coord[cell_nodes[cell * 8 + face_nodes[face][i]]],
+                                node_coord[cell_nodes[cell * 8 + face_nodes[face][(i + 1) % 4]]]);
+      }
+    }
+  }
+
+  // Particules.
+  std::mt19937_64 gen(1029384756);
+  std::uniform_real_distribution<Real> uniform(0.0, 1.0);
+  std::uniform_int_distribution<Int32> cell_dist(0, nb_cell - 1);
+
+  UniqueArray<Int32> particle_cell(nb_particle);
+  UniqueArray<Real3> particle_coord(nb_particle);
+  UniqueArray<Real3> particle_dir_cos(nb_particle);
+  for (Integer p = 0; p < nb_particle; p++) {
+    const Int32 cell = cell_dist(gen);
+    particle_cell[p] = cell;
+    const Real3 origin = node_coord[cell_nodes[cell * 8]];
+    particle_coord[p] = origin + Real3(uniform(gen), uniform(gen), uniform(gen));
+    const Real cos_theta = 2.0 * uniform(gen) - 1.0;
+    const Real sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+    const Real phi = 2.0 * PhysicalConstants::_pi * uniform(gen);
+    particle_dir_cos[p] = Real3(sin_theta * std::cos(phi), sin_theta * std::sin(phi), cos_theta);
+  }
+
+  std::cout << "Cells     : " << nb_cell << "\n"
+            << "Particles : " << nb_particle << "\n";
+
+  Integer nb_mismatch = 0;
+
+  // Particules dans un ordre aléatoire (accès dispersés à la géométrie).
+  nb_mismatch += runBench("random", mesh, particle_cell, particle_coord, particle_dir_cos);
+
+  // Particules triées par maille (cas du tracking où plusieurs particules
+  // d'une même maille sont traitées à la suite).
+  UniqueArray<Int32> sorted_index(nb_particle);
+  for (Integer p = 0; p < nb_particle; p++) {
+    sorted_index[p] = p;
+  }
+  std::stable_sort(sorted_index.begin(), sorted_index.end(),
+                   [&](Int32 a, Int32 b) { return particle_cell[a] < particle_cell[b]; });
+
+  UniqueArray<Int32> sorted_cell(nb_particle);
+  UniqueArray<Real3> sorted_coord(nb_particle);
+  UniqueArray<Real3> sorted_dir_cos(nb_particle);
+  for (Integer p = 0; p < nb_particle; p++) {
+    sorted_cell[p] = particle_cell[sorted_index[p]];
+    sorted_coord[p] = particle_coord[sorted_index[p]];
+    sorted_dir_cos[p] = particle_dir_cos[sorted_index[p]];
+  }
+  nb_mismatch += runBench("sorted", mesh, sorted_cell, sorted_coord, sorted_dir_cos);
+
+  return (nb_mismatch == 0) ? 0 : 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
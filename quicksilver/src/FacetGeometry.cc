@@ -0,0 +1,277 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* FacetGeometry.cc                                            (C) 2000-2022 */
+/*                                                                           */
+/* Géométrie des facets des mailles hexaédriques QAMA                        */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "FacetGeometry.hh"
+#include "PhysicalConstants.hh"
+#include <cmath>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Méthode permettant d'allouer le stockage.
+ *
+ * @param nb_cell Le nombre de mailles (maxLocalId() de la famille).
+ */
+void FacetGeometry::
+resize(Integer nb_cell)
+{
+  m_data.resize(static_cast<Int64>(nb_cell) * CELL_STRIDE);
+  m_data.fill(0.0);
+}
+
+/**
+ * @brief Méthode permettant de définir une facet d'une maille.
+ *
+ * @param cell_lid Le localId de la maille.
+ * @param facet L'indice de la facet dans la maille.
+ * @param normal La normale sortante de la face (A, B, C).
+ * @param d Le coefficient D du plan de la face.
+ * @param point0 Le centre de la face.
+ * @param point1 Le premier node du segment.
+ * @param point2 Le second node du segment.
+ */
+void FacetGeometry::
+setFacet(Int32 cell_lid, Integer facet, const Real3& normal, Real d,
+         const Real3& point0, const Real3& point1, const Real3& point2)
+{
+  field(cell_lid, F_A)[facet] = normal.x;
+  field(cell_lid, F_B)[facet] = normal.y;
+  field(cell_lid, F_C)[facet] = normal.z;
+  field(cell_lid, F_D)[facet] = d;
+  field(cell_lid, F_P0X)[facet] = point0.x;
+  field(cell_lid, F_P0Y)[facet] = point0.y;
+  field(cell_lid, F_P0Z)[facet] = point0.z;
+  field(cell_lid, F_P1X)[facet] = point1.x;
+  field(cell_lid, F_P1Y)[facet] = point1.y;
+  field(cell_lid, F_P1Z)[facet] = point1.z;
+  field(cell_lid, F_P2X)[facet] = point2.x;
+  field(cell_lid, F_P2Y)[facet] = point2.y;
+  field(cell_lid, F_P2Z)[facet] = point2.z;
+}
+
+/**
+ * @brief Méthode permettant de calculer la distance d'une particule aux
+ * 24 facets de sa maille.
+ *
+ * Même critère que distanceToSegmentFacet() (avec allow_enter = false),
+ * mais sans branchement : chaque facet est un couloir de la boucle.
+ * Le test d'appartenance au triangle utilise les produits vectoriels des
+ * arêtes projetés sur la normale, ce qui donne les mêmes signes que la
+ * projection 2D de distanceToSegmentFacet() (à un facteur commun près).
+ *
+ * @param cell_lid Le localId de la maille.
+ * @param plane_tolerance La tolérance sur le plan (cf. getNearestFacet()).
+ * @param particle_coord La position de la particule.
+ * @param particle_dir_cos Les cosinus directeurs de la particule.
+ * @param distance Le tableau (de taille NB_FACET) des distances calculées.
+ */
+void FacetGeometry::
+computeDistances(Int32 cell_lid, Real plane_tolerance,
+                 const Real3& particle_coord, const Real3& particle_dir_cos,
+                 Real* distance) const
+{
+  const Real* __restrict__ a = field(cell_lid, F_A);
+  const Real* __restrict__ b = field(cell_lid, F_B);
+  const Real* __restrict__ c = field(cell_lid, F_C);
+  const Real* __restrict__ d = field(cell_lid, F_D);
+  const Real* __restrict__ p0x = field(cell_lid, F_P0X);
+  const Real* __restrict__ p0y = field(cell_lid, F_P0Y);
+  const Real* __restrict__ p0z = field(cell_lid, F_P0Z);
+  const Real* __restrict__ p1x = field(cell_lid, F_P1X);
+  const Real* __restrict__ p1y = field(cell_lid, F_P1Y);
+  const Real* __restrict__ p1z = field(cell_lid, F_P1Z);
+  const Real* __restrict__ p2x = field(cell_lid, F_P2X);
+  const Real* __restrict__ p2y = field(cell_lid, F_P2Y);
+  const Real* __restrict__ p2z = field(cell_lid, F_P2Z);
+
+  const Real x = particle_coord.x;
+  const Real y = particle_coord.y;
+  const Real z = particle_coord.z;
+  const Real dx = particle_dir_cos.x;
+  const Real dy = particle_dir_cos.y;
+  const Real dz = particle_dir_cos.z;
+
+  for (Integer f = 0; f < NB_FACET; f++) {
+    const Real normal_dot_dir = a[f] * dx + b[f] * dy + c[f] * dz;
+    const Real numerator = -(a[f] * x + b[f] * y + c[f] * z + d[f]);
+
+    // Si normal_dot_dir est nul, la facet est de toute façon rejetée
+    // par le test leaving.
+    const Real dist = numerator / normal_dot_dir;
+
+    const Real ix = x + dist * dx;
+    const Real iy = y + dist * dy;
+    const Real iz = z + dist * dz;
+
+    // ((p1 - p0) x (i - p0)) . n
+    const Real ux0 = p1x[f] - p0x[f], uy0 = p1y[f] - p0y[f], uz0 = p1z[f] - p0z[f];
+    const Real vx0 = ix - p0x[f], vy0 = iy - p0y[f], vz0 = iz - p0z[f];
+    const Real cross0 = a[f] * (uy0 * vz0 - uz0 * vy0) + b[f] * (uz0 * vx0 - ux0 * vz0) + c[f] * (ux0 * vy0 - uy0 * vx0);
+
+    // ((p2 - p1) x (i - p1)) . n
+    const Real ux1 = p2x[f] - p1x[f], uy1 = p2y[f] - p1y[f], uz1 = p2z[f] - p1z[f];
+    const Real vx1 = ix - p1x[f], vy1 = iy - p1y[f], vz1 = iz - p1z[f];
+    const Real cross1 = a[f] * (uy1 * vz1 - uz1 * vy1) + b[f] * (uz1 * vx1 - ux1 * vz1) + c[f] * (ux1 * vy1 - uy1 * vx1);
+
+    // ((p0 - p2) x (i - p2)) . n
+    const Real ux2 = p0x[f] - p2x[f], uy2 = p0y[f] - p2y[f], uz2 = p0z[f] - p2z[f];
+    const Real vx2 = ix - p2x[f], vy2 = iy - p2y[f], vz2 = iz - p2z[f];
+    const Real cross2 = a[f] * (uy2 * vz2 - uz2 * vy2) + b[f] * (uz2 * vx2 - ux2 * vz2) + c[f] * (ux2 * vy2 - uy2 * vx2);
+
+    const Real cross_tol = 1e-9 * std::abs(cross0 + cross1 + cross2);
+
+    // Opérateurs & et | (et non && et ||) pour ne pas introduire de
+    // branchement qui empêcherait la vectorisation.
+    const bool leaving = (normal_dot_dir > 0.0);
+    const bool too_negative = (numerator < 0.0) & (numerator * numerator > plane_tolerance);
+    const bool inside = ((cross0 > -cross_tol) & (cross1 > -cross_tol) & (cross2 > -cross_tol)) |
+    ((cross0 < cross_tol) & (cross1 < cross_tol) & (cross2 < cross_tol));
+
+    distance[f] = (leaving & !too_negative & inside) ? dist : PhysicalConstants::_hugeDouble;
+  }
+}
+
+/**
+ * @brief Méthode permettant de trouver la distance entre une facet et une particule.
+ * Version d'origine (une facet à la fois), utilisée sans géométrie précalculée.
+ * 
+ * @param plane_tolerance 
+ * @param facet_normal_dot_direction_cosine 
+ * @param A 
+ * @param B 
+ * @param C 
+ * @param D 
+ * @param facet_coords0 
+ * @param facet_coords1 
+ * @param facet_coords2 
+ * @param particle_coord 
+ * @param particle_dir_cos 
+ * @param allow_enter 
+ * @return Real 
+ */
+Real FacetGeometry::
+distanceToSegmentFacet(const Real& plane_tolerance,
+                       const Real& facet_normal_dot_direction_cosine,
+                       const Real& A, const Real& B, const Real& C, const Real& D,
+                       const Real3& facet_coords0,
+                       const Real3& facet_coords1,
+                       const Real3& facet_coords2,
+                       const Real3& particle_coord,
+                       const Real3& particle_dir_cos,
+                       bool allow_enter)
+{
+  Real boundingBox_tolerance = 1e-9;
+  Real numerator = -1.0 * (A * particle_coord.x + B * particle_coord.y + C * particle_coord.z + D);
+
+  /* Plane equation: numerator = -P(x,y,z) = -(Ax + By + Cz + D)
+      if: numerator < -1e-8*length(x,y,z)   too negative!
+      if: numerator < 0 && numerator^2 > ( 1e-8*length(x,y,z) )^2   too negative!
+      reverse inequality since squaring function is decreasing for negative inputs.
+      If numerator is just SLIGHTLY negative, then the particle is just outside of the face */
+
+  // Filter out too negative distances
+  if (!allow_enter && numerator < 0.0 && numerator * numerator > plane_tolerance) {
+    return PhysicalConstants::_hugeDouble;
+  }
+
+  // we have to restrict the solution to within the triangular face
+  Real distance = numerator / facet_normal_dot_direction_cosine;
+
+  // see if the intersection point of the ray and the plane is within the triangular facet
+  Real3 intersection_pt;
+  intersection_pt.x = particle_coord.x + distance * particle_dir_cos.x;
+  intersection_pt.y = particle_coord.y + distance * particle_dir_cos.y;
+  intersection_pt.z = particle_coord.z + distance * particle_dir_cos.z;
+
+  // if the point is completely below the triangle, it is not in the triangle
+#define IF_POINT_BELOW_CONTINUE(axis) \
+  if (facet_coords0.axis > intersection_pt.axis + boundingBox_tolerance && \
+      facet_coords1.axis > intersection_pt.axis + boundingBox_tolerance && \
+      facet_coords2.axis > intersection_pt.axis + boundingBox_tolerance) { \
+    return PhysicalConstants::_hugeDouble; \
+  }
+
+#define IF_POINT_ABOVE_CONTINUE(axis) \
+  if (facet_coords0.axis < intersection_pt.axis - boundingBox_tolerance && \
+      facet_coords1.axis < intersection_pt.axis - boundingBox_tolerance && \
+      facet_coords2.axis < intersection_pt.axis - boundingBox_tolerance) { \
+    return PhysicalConstants::_hugeDouble; \
+  }
+
+  // Is the intersection point inside the triangular facet?  Project to 2D and see.
+
+  // A^2 + B^2 + C^2 = 1, so max(|A|,|B|,|C|) >= 1/sqrt(3) = 0.577
+  // (all coefficients can't be small)
+#define AB_CROSS_AC(ax, ay, bx, by, cx, cy) ((bx - ax) * (cy - ay) - (by - ay) * (cx - ax))
+  Real cross0 = 0, cross1 = 0, cross2 = 0;
+  if (C < -0.5 || C > 0.5) {
+    IF_POINT_BELOW_CONTINUE(x);
+    IF_POINT_ABOVE_CONTINUE(x);
+    IF_POINT_BELOW_CONTINUE(y);
+    IF_POINT_ABOVE_CONTINUE(y);
+
+    cross1 = AB_CROSS_AC(facet_coords0.x, facet_coords0.y,
+                         facet_coords1.x, facet_coords1.y,
+                         intersection_pt.x, intersection_pt.y);
+    cross2 = AB_CROSS_AC(facet_coords1.x, facet_coords1.y,
+                         facet_coords2.x, facet_coords2.y,
+                         intersection_pt.x, intersection_pt.y);
+    cross0 = AB_CROSS_AC(facet_coords2.x, facet_coords2.y,
+                         facet_coords0.x, facet_coords0.y,
+                         intersection_pt.x, intersection_pt.y);
+  }
+  else if (B < -0.5 || B > 0.5) {
+    IF_POINT_BELOW_CONTINUE(x);
+    IF_POINT_ABOVE_CONTINUE(x);
+    IF_POINT_BELOW_CONTINUE(z);
+    IF_POINT_ABOVE_CONTINUE(z);
+
+    cross1 = AB_CROSS_AC(facet_coords0.z, facet_coords0.x,
+                         facet_coords1.z, facet_coords1.x,
+                         intersection_pt.z, intersection_pt.x);
+    cross2 = AB_CROSS_AC(facet_coords1.z, facet_coords1.x,
+                         facet_coords2.z, facet_coords2.x,
+                         intersection_pt.z, intersection_pt.x);
+    cross0 = AB_CROSS_AC(facet_coords2.z, facet_coords2.x,
+                         facet_coords0.z, facet_coords0.x,
+                         intersection_pt.z, intersection_pt.x);
+  }
+  else if (A < -0.5 || A > 0.5) {
+    IF_POINT_BELOW_CONTINUE(z);
+    IF_POINT_ABOVE_CONTINUE(z);
+    IF_POINT_BELOW_CONTINUE(y);
+    IF_POINT_ABOVE_CONTINUE(y);
+
+    cross1 = AB_CROSS_AC(facet_coords0.y, facet_coords0.z,
+                         facet_coords1.y, facet_coords1.z,
+                         intersection_pt.y, intersection_pt.z);
+    cross2 = AB_CROSS_AC(facet_coords1.y, facet_coords1.z,
+                         facet_coords2.y, facet_coords2.z,
+                         intersection_pt.y, intersection_pt.z);
+    cross0 = AB_CROSS_AC(facet_coords2.y, facet_coords2.z,
+                         facet_coords0.y, facet_coords0.z,
+                         intersection_pt.y, intersection_pt.z);
+  }
+
+  Real cross_tol = 1e-9 * std::abs(cross0 + cross1 + cross2); // cross product tolerance
+
+  if ((cross0 > -cross_tol && cross1 > -cross_tol && cross2 > -cross_tol) ||
+      (cross0 < cross_tol && cross1 < cross_tol && cross2 < cross_tol)) {
+    return distance;
+  }
+  return PhysicalConstants::_hugeDouble;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -28,6 +28,10 @@ public:
 public:
   virtual void init(String name_csv, String separator) = 0;
 
+  // Mode flux : une ligne par colonne ajoutée (une ligne par itération),
+  // écrite au fil de l'eau dans path_file. A appeler après init().
+  virtual bool initStream(String path_file, Integer flush_period, bool gather_ranks) = 0;
+
   virtual Integer addRow(String name_line, bool fill_start = false) = 0;
   virtual Integer addRow(String name_line, ConstArrayView<Real>& elems) = 0;
   virtual Integer addColumn(String name_column, bool fill_start = false) = 0;
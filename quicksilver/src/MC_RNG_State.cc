@@ -3,6 +3,23 @@
 
 //---------------------------------------------------------------------------//
 
+namespace RngDetail
+{
+eRngKind rng_kind = eRngKind::LCG;
+} // namespace RngDetail
+
+//----------------------------------------------------------------------------------------------------------------------
+//  This routine selects the random number generator.
+//----------------------------------------------------------------------------------------------------------------------
+
+void
+rngInit(eRngKind kind)
+{
+  RngDetail::rng_kind = kind;
+}
+
+//---------------------------------------------------------------------------//
+
 namespace
 {
 
@@ -111,7 +128,16 @@ hash_state(uint64_t initial_number)
 Int64 
 rngSpawn_Random_Number_Seed(Int64* parent_seed)
 {
-  Int64 spawned_seed = hash_state(*parent_seed);
+  Int64 spawned_seed;
+  if (RngDetail::rng_kind == eRngKind::PHILOX) {
+    // The child counter starts at a position of the 2^64 sequence derived
+    // from the parent counter (with another key, so that it does not
+    // overlap the samples of the parent).
+    spawned_seed = RngDetail::philox2x32(static_cast<uint64_t>(*parent_seed), RngDetail::philox_spawn_key);
+  }
+  else {
+    spawned_seed = hash_state(*parent_seed);
+  }
   // Bump the parent seed as that is what is expected from the interface.
   rngSample(parent_seed);
   return spawned_seed;
@@ -11,15 +11,89 @@
 #include <arcane/ITimeLoopMng.h>
 #include <math.h>
 
+#include "structEnum.hh"
+
 using namespace Arcane;
 
 //----------------------------------------------------------------------------------------------------------------------
-//  A random number generator that implements a 64 bit linear congruential
-//  generator (lcg).
+//  Two random number generators are available (selected once with rngInit()):
+//
+//  - LCG : a 64 bit linear congruential generator (lcg), the seed is the
+//    state of the generator. This implementation is based on the rng class
+//    from Nick Gentile.
+//
+//  - PHILOX : a counter-based generator (Philox2x32-10, Salmon et al.
+//    "Parallel random numbers: as easy as 1, 2, 3", SC'11). The seed is a
+//    64 bit counter : the n-th sample of a particle is a pure function of
+//    (seed at birth + n), i.e. of the particle (its uniqueId derives from its
+//    seed at birth) and of its number of samples. Several samples can
+//    therefore be computed independently (rngSampleN()).
 //
-//  This implementation is based on the rng class from Nick Gentile.
+//  In both cases, the state of a particle is a single Int64 (m_particle_rns)
+//  which moves with the particle, so the results do not depend on the
+//  number of ranks or threads.
 //----------------------------------------------------------------------------------------------------------------------
 
+namespace RngDetail
+{
+extern eRngKind rng_kind;
+
+const uint32_t philox_key = 0x2d3b7e4fU;
+const uint32_t philox_spawn_key = 0x5f1a96c3U;
+
+inline uint64_t
+philox2x32(uint64_t counter, uint32_t key)
+{
+  const uint32_t M = 0xD256D193U;
+  const uint32_t W = 0x9E3779B9U;
+
+  uint32_t c0 = static_cast<uint32_t>(counter >> 32);
+  uint32_t c1 = static_cast<uint32_t>(counter);
+
+  for (int round = 0; round < 10; round++) {
+    const uint64_t product = static_cast<uint64_t>(M) * c0;
+    const uint32_t hi = static_cast<uint32_t>(product >> 32);
+    const uint32_t lo = static_cast<uint32_t>(product);
+    c0 = hi ^ key ^ c1;
+    c1 = lo;
+    key += W;
+  }
+  return (static_cast<uint64_t>(c0) << 32) | c1;
+}
+
+// Map the 53 high bits to a double in (0,1) (never 0, log() is applied to
+// some samples).
+inline Real
+philoxToReal(uint64_t bits)
+{
+  return (static_cast<Real>(bits >> 11) + 0.5) * 1.1102230246251565e-16;
+}
+
+inline Real
+lcgSample(Int64* seed)
+{
+  // Reset the state from the previous value.
+  *seed = 2862933555777941757ULL * (uint64_t)(*seed) + 3037000493ULL;
+  //*seed &= ~(1UL << 63);
+  // Map the int state in (0,2**64) to double (0,1)
+  // by multiplying by
+  // 1/(2**64 - 1) = 1/18446744073709551615.
+  return 5.4210108624275222e-20 * (uint64_t)(*seed);
+}
+
+inline Real
+philoxSample(Int64* seed)
+{
+  const uint64_t counter = static_cast<uint64_t>(*seed);
+  *seed = static_cast<Int64>(counter + 1);
+  return philoxToReal(philox2x32(counter, philox_key));
+}
+} // namespace RngDetail
+
+// Select the generator (to be called once, before any sample).
+
+void rngInit(eRngKind kind);
+
 // Generate a new random number seed
 
 Int64 rngSpawn_Random_Number_Seed(Int64* parent_seed);
@@ -32,15 +106,32 @@ Int64 rngSpawn_Random_Number_Seed(Int64* parent_seed);
 inline Real
 rngSample(Int64* seed)
 {
-  // Reset the state from the previous value.
-  *seed = 2862933555777941757ULL * (uint64_t)(*seed) + 3037000493ULL;
-  //*seed &= ~(1UL << 63);
-  // Map the int state in (0,2**64) to double (0,1)
-  // by multiplying by
-  // 1/(2**64 - 1) = 1/18446744073709551615.
-  volatile Real fin = 5.4210108624275222e-20 * (uint64_t)(*seed);
+  Real fin = (RngDetail::rng_kind == eRngKind::PHILOX) ? RngDetail::philoxSample(seed) : RngDetail::lcgSample(seed);
   ARCANE_ASSERT(fin >= 0, "rngSample negative");
   return fin;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+//  SampleN returns nb_sample pseudo-random numbers, the same ones as nb_sample
+//  calls to rngSample(). With PHILOX, the samples are independent and the
+//  loop can be vectorized.
+//----------------------------------------------------------------------------------------------------------------------
+
+inline void
+rngSampleN(Int64* seed, Integer nb_sample, Real* samples)
+{
+  if (RngDetail::rng_kind == eRngKind::PHILOX) {
+    const uint64_t counter = static_cast<uint64_t>(*seed);
+    for (Integer i = 0; i < nb_sample; i++) {
+      samples[i] = RngDetail::philoxToReal(RngDetail::philox2x32(counter + i, RngDetail::philox_key));
+    }
+    *seed = static_cast<Int64>(counter + nb_sample);
+  }
+  else {
+    for (Integer i = 0; i < nb_sample; i++) {
+      samples[i] = RngDetail::lcgSample(seed);
+    }
+  }
+}
+
 #endif
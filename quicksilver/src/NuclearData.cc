@@ -44,19 +44,22 @@ NuclearDataReaction(Enum reactionType, Real nuBar,
 
 void NuclearDataReaction::
 sampleCollision(Real incidentEnergy,
-                Real material_mass, RealUniqueArray& energyOut,
-                RealUniqueArray& angleOut, Integer& nOut,
+                Real material_mass, ArrayView<Real> energyOut,
+                ArrayView<Real> angleOut, Integer& nOut,
                 Int64* seed,
                 Integer max_production_size)
 {
   Real randomNumber;
+  // Two samples (energy, angle) per outgoing particle.
+  Real randomNumbers[2];
   switch (_reactionType) {
   case Scatter:
     nOut = 1;
-    randomNumber = rngSample(seed);
+    rngSampleN(seed, 2, randomNumbers);
+    randomNumber = randomNumbers[0];
     energyOut[0] =
     incidentEnergy * (1.0 - (randomNumber * (1.0 / material_mass)));
-    randomNumber = rngSample(seed) * 2.0 - 1.0;
+    randomNumber = randomNumbers[1] * 2.0 - 1.0;
     angleOut[0] = randomNumber;
     break;
   case Absorption:
@@ -70,9 +73,10 @@ sampleCollision(Real incidentEnergy,
 #endif
     nOut = numParticleOut;
     for (Integer outIndex = 0; outIndex < numParticleOut; outIndex++) {
-      randomNumber = rngSample(seed) / 2.0 + 0.5;
+      rngSampleN(seed, 2, randomNumbers);
+      randomNumber = randomNumbers[0] / 2.0 + 0.5;
       energyOut[outIndex] = (20 * randomNumber * randomNumber);
-      randomNumber = rngSample(seed) * 2.0 - 1.0;
+      randomNumber = randomNumbers[1] * 2.0 - 1.0;
       angleOut[outIndex] = randomNumber;
     }
   } break;
@@ -113,6 +117,8 @@ NuclearData(Integer numGroups, Real energyLow, Real energyHigh)
   Real logLow = log(energyLow);
   Real logHigh = log(energyHigh);
   Real delta = (logHigh - logLow) / (numGroups + 1.0);
+  m_logEnergyLow = logLow;
+  m_invLogDelta = 1.0 / delta;
   for (Integer energyIndex = 1; energyIndex < numGroups; energyIndex++) {
     Real logValue = logLow + delta * energyIndex;
     _energies[energyIndex] = exp(logValue);
@@ -193,6 +199,9 @@ getNumberReactions(Integer isotopeIndex)
 }
 
 // For this energy, return the group index
+// The boundaries are log-uniform (except the last one), so the group is
+// computed directly and then corrected by comparing with the boundaries
+// (at most one step, for rounding errors and the last group).
 
 Integer NuclearData::
 getEnergyGroup(Real energy)
@@ -203,18 +212,15 @@ getEnergyGroup(Real energy)
   if (energy > _energies[numEnergies - 1])
     return numEnergies - 1;
 
-  Integer high = numEnergies - 1;
-  Integer low = 0;
+  Integer group = (Integer)((log(energy) - m_logEnergyLow) * m_invLogDelta);
+  group = std::min(std::max(group, 0), numEnergies - 2);
 
-  while (high != low + 1) {
-    Integer mid = (high + low) / 2;
-    if (energy < _energies[mid])
-      high = mid;
-    else
-      low = mid;
-  }
+  while (group > 0 && energy < _energies[group])
+    group--;
+  while (group < numEnergies - 2 && energy >= _energies[group + 1])
+    group++;
 
-  return low;
+  return group;
 }
 
 // General routines to help access data lower down
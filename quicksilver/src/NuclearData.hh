@@ -51,8 +51,8 @@ class NuclearDataReaction
 
   Real getCrossSection(Integer group);
 
-  void sampleCollision(Real incidentEnergy, Real material_mass, RealUniqueArray& energyOut,
-                       RealUniqueArray& angleOut, Integer& nOut, Int64* seed,
+  void sampleCollision(Real incidentEnergy, Real material_mass, ArrayView<Real> energyOut,
+                       ArrayView<Real> angleOut, Integer& nOut, Int64* seed,
                        Integer max_production_size);
 
   RealUniqueArray _crossSection; //!< tabular data for microscopic cross section
@@ -110,6 +110,9 @@ class NuclearData
   // This is the overall energy layout. If we had more than just
   // neutrons, this array would be a vector of vectors.
   RealUniqueArray _energies;
+  // Pour le calcul direct du groupe (les bornes sont log-uniformes).
+  Real m_logEnergyLow;
+  Real m_invLogDelta;
   Real m_totalCrossSection;
   bool m_totalCrossSectionAC;
 };
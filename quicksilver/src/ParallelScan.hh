@@ -0,0 +1,104 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ParallelScan.hh                                             (C) 2000-2022 */
+/*                                                                           */
+/* Somme préfixe et compaction parallèles QAMA                               */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef PARALLELSCAN_HH
+#define PARALLELSCAN_HH
+
+#include <arcane/Concurrency.h>
+#include <arcane/utils/UniqueArray.h>
+
+using namespace Arcane;
+
+/**
+ * @brief Méthode permettant de calculer en parallèle la somme préfixe
+ * exclusive d'un tableau : offsets[i] = counts[0] + ... + counts[i-1].
+ *
+ * Le tableau est découpé en blocs : la somme de chaque bloc est calculée
+ * en parallèle, les sommes des blocs sont cumulées séquentiellement, puis
+ * chaque bloc est parcouru une seconde fois en parallèle. Le résultat ne
+ * dépend pas du nombre de threads.
+ *
+ * @param counts Le nombre d'éléments associés à chaque indice.
+ * @param offsets Le tableau des sommes (même taille que counts).
+ * @return Integer La somme de tous les counts.
+ */
+inline Integer
+parallelExclusiveScan(ConstArrayView<Int32> counts, ArrayView<Int32> offsets)
+{
+  const Integer size = counts.size();
+  if (size == 0) {
+    return 0;
+  }
+
+  const Integer nb_block = std::min(size, 4 * TaskFactory::nbAllowedThread());
+  const Integer block_size = (size + nb_block - 1) / nb_block;
+
+  Int32UniqueArray block_offsets(nb_block + 1);
+  block_offsets[0] = 0;
+
+  arcaneParallelFor(0, nb_block, [&](Integer begin, Integer nb) {
+    for (Integer block = begin; block < (begin + nb); block++) {
+      const Integer end = std::min(size, (block + 1) * block_size);
+      Integer sum = 0;
+      for (Integer i = block * block_size; i < end; i++) {
+        sum += counts[i];
+      }
+      block_offsets[block + 1] = sum;
+    }
+  });
+
+  for (Integer block = 0; block < nb_block; block++) {
+    block_offsets[block + 1] += block_offsets[block];
+  }
+
+  arcaneParallelFor(0, nb_block, [&](Integer begin, Integer nb) {
+    for (Integer block = begin; block < (begin + nb); block++) {
+      const Integer end = std::min(size, (block + 1) * block_size);
+      Integer sum = block_offsets[block];
+      for (Integer i = block * block_size; i < end; i++) {
+        offsets[i] = sum;
+        sum += counts[i];
+      }
+    }
+  });
+
+  return block_offsets[nb_block];
+}
+
+/**
+ * @brief Méthode permettant de compacter en parallèle les valeurs dont le
+ * drapeau est non nul, en conservant leur ordre.
+ *
+ * @param flags Les drapeaux (0 ou 1).
+ * @param values Les valeurs (même taille que flags).
+ * @param compacted Le tableau des valeurs conservées (redimensionné).
+ */
+inline void
+parallelCompact(ConstArrayView<Int32> flags, ConstArrayView<Int32> values, Int32Array& compacted)
+{
+  Int32UniqueArray offsets(flags.size());
+  const Integer nb_compacted = parallelExclusiveScan(flags, offsets);
+
+  compacted.resize(nb_compacted);
+  ArrayView<Int32> compacted_view = compacted.view();
+
+  arcaneParallelFor(0, flags.size(), [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      if (flags[i] != 0) {
+        compacted_view[offsets[i]] = values[i];
+      }
+    }
+  });
+}
+
+#endif
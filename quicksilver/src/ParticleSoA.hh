@@ -0,0 +1,136 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ParticleSoA.hh                                              (C) 2000-2022 */
+/*                                                                           */
+/* Etat des particules en structure de tableaux pour le tracking par         */
+/* événements QAMA                                                           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef PARTICLESOA_HH
+#define PARTICLESOA_HH
+
+#include <arcane/utils/UniqueArray.h>
+
+using namespace Arcane;
+
+/**
+ * @brief Structure contenant l'état "chaud" des particules suivies par le
+ * moteur de tracking par événements.
+ * L'indice d'une particule dans chaque tableau correspond à sa position
+ * dans la vue des particules suivies lors de la sous-itération.
+ * Les composantes des Real3 sont stockées dans des tableaux distincts pour
+ * que les boucles sur les lots d'événements puissent être vectorisées.
+ */
+struct ParticleSoA
+{
+  Integer size() const { return local_id.size(); }
+
+  void resize(Integer nb_particle)
+  {
+    local_id.resize(nb_particle);
+    cell_id.resize(nb_particle);
+
+    coord_x.resize(nb_particle);
+    coord_y.resize(nb_particle);
+    coord_z.resize(nb_particle);
+
+    velocity_x.resize(nb_particle);
+    velocity_y.resize(nb_particle);
+    velocity_z.resize(nb_particle);
+
+    dir_cos_a.resize(nb_particle);
+    dir_cos_b.resize(nb_particle);
+    dir_cos_g.resize(nb_particle);
+
+    kin_ene.resize(nb_particle);
+    weight.resize(nb_particle);
+    time_census.resize(nb_particle);
+    total_cross_section.resize(nb_particle);
+    age.resize(nb_particle);
+    num_mean_free_path.resize(nb_particle);
+    mean_free_path.resize(nb_particle);
+    seg_path_length.resize(nb_particle);
+    num_seg.resize(nb_particle);
+
+    rns.resize(nb_particle);
+
+    last_event.resize(nb_particle);
+    status.resize(nb_particle);
+    ene_grp.resize(nb_particle);
+    face.resize(nb_particle);
+    facet.resize(nb_particle);
+  }
+
+  /**
+   * @brief Méthode permettant de réserver les listes de particules des lots
+   * d'événements, une fois par cycle. Un lot ne contient jamais plus de
+   * nb_particle particules : les add() faits à chaque lot ne réallouent
+   * donc pas.
+   * Les tableaux des produits de collision ne sont pas réservés ici : ils
+   * sont dimensionnés par collisionEventBatch() au lot de collisions traité
+   * et ne grandissent que si un lot dépasse les précédents.
+   *
+   * @param nb_particle Le nombre de particules suivies.
+   */
+  void reserveScratch(Integer nb_particle)
+  {
+    active.reserve(nb_particle);
+    census_batch.reserve(nb_particle);
+    collision_batch.reserve(nb_particle);
+    facet_batch.reserve(nb_particle);
+  }
+
+  Int32UniqueArray local_id; //!< LocalId de la particule.
+  Int32UniqueArray cell_id; //!< LocalId de la maille contenant la particule.
+
+  RealUniqueArray coord_x;
+  RealUniqueArray coord_y;
+  RealUniqueArray coord_z;
+
+  RealUniqueArray velocity_x;
+  RealUniqueArray velocity_y;
+  RealUniqueArray velocity_z;
+
+  RealUniqueArray dir_cos_a;
+  RealUniqueArray dir_cos_b;
+  RealUniqueArray dir_cos_g;
+
+  RealUniqueArray kin_ene;
+  RealUniqueArray weight;
+  RealUniqueArray time_census;
+  RealUniqueArray total_cross_section;
+  RealUniqueArray age;
+  RealUniqueArray num_mean_free_path;
+  RealUniqueArray mean_free_path;
+  RealUniqueArray seg_path_length;
+  RealUniqueArray num_seg;
+
+  Int64UniqueArray rns;
+
+  Int32UniqueArray last_event;
+  Int32UniqueArray status;
+  Int32UniqueArray ene_grp;
+  Int32UniqueArray face;
+  Int32UniqueArray facet;
+
+  // Tableaux de travail des lots (cf. reserveScratch()).
+  Int32UniqueArray active; //!< Particules encore suivies.
+  Int32UniqueArray census_batch;
+  Int32UniqueArray collision_batch;
+  Int32UniqueArray facet_batch;
+
+  // Produits des collisions du lot courant (cf. collisionEventBatch()).
+  RealUniqueArray energy_out; //!< max_production_size produits par collision.
+  RealUniqueArray angle_out;
+  Int64UniqueArray child_rns;
+  Int32UniqueArray n_out;
+  Int32UniqueArray reaction_type;
+};
+
+#endif
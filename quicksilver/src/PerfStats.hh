@@ -0,0 +1,52 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* PerfStats.hh                                                (C) 2000-2022 */
+/*                                                                           */
+/* Sortie des temps par sous-domaine QAMA                                    */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef PERFSTATS_HH
+#define PERFSTATS_HH
+
+#include <arcane/IParallelMng.h>
+#include "ISimpleOutput.hh"
+
+using namespace Arcane;
+
+/**
+ * @brief Méthode permettant d'ajouter dans le csv le minimum, le maximum et
+ * la moyenne sur les sous-domaines d'une grandeur propre à chaque
+ * sous-domaine (lignes "name min", "name max" et "name avg").
+ * Un écart important entre le maximum et la moyenne indique un déséquilibre
+ * de charge.
+ * Doit être appelée par tous les sous-domaines.
+ *
+ * @param csv La sortie csv.
+ * @param pm Le gestionnaire du parallélisme.
+ * @param name Le nom de la grandeur.
+ * @param value La valeur du sous-domaine.
+ * @return Real Le maximum sur les sous-domaines.
+ */
+inline Real
+addMinMaxAvgRows(ISimpleOutput* csv, IParallelMng* pm, const String& name, Real value)
+{
+  Real min_value = 0.0;
+  Real max_value = 0.0;
+  Real sum_value = 0.0;
+  Int32 min_rank = 0;
+  Int32 max_rank = 0;
+  pm->computeMinMaxSum(value, min_value, max_value, sum_value, min_rank, max_rank);
+
+  csv->addElemRow(name + " min", min_value);
+  csv->addElemRow(name + " max", max_value);
+  csv->addElemRow(name + " avg", sum_value / pm->commSize());
+  return max_value;
+}
+
+#endif
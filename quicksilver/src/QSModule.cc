@@ -12,6 +12,11 @@
 /*---------------------------------------------------------------------------*/
 
 #include "QSModule.hh"
+#include "MC_RNG_State.hh"
+#include <arcane/Concurrency.h>
+#include <arcane/IVariable.h>
+#include <arcane/VariableCollection.h>
+#include <algorithm>
 #include <iostream>
 
 /*---------------------------------------------------------------------------*/
@@ -24,6 +29,9 @@
 void QSModule::
 initModule()
 {
+  // Choix du générateur de nombres aléatoires (avant tout tirage).
+  rngInit(options()->getRng());
+
   m_cartesian_mesh = ICartesianMesh::getReference(mesh(), true);
   m_cartesian_mesh->computeDirections();
   initMesh();
@@ -32,6 +40,11 @@ initModule()
   // Initialisation de la sortie CSV.
   ISimpleOutput* csv = ServiceBuilder<ISimpleOutput>(subDomain()).getSingleton();
   csv->init("QAMA", ";");
+  if (options()->getCsvFile() != "" && options()->getCsvMode() == eCsvMode::CSV_STREAM) {
+    csv->initStream(options()->getCsvFile(), options()->getCsvFlushPeriod(), options()->getCsvGatherRanks());
+  }
+
+  m_timer_sort = new Timer(subDomain(), "QSSort", Timer::TimerReal);
 }
 
 /**
@@ -40,6 +53,22 @@ initModule()
 void QSModule::
 cycleFinalize()
 {
+  const eParticleSort sort = options()->getParticleSort();
+  const Integer sort_period = options()->getParticleSortPeriod();
+
+  if (sort != eParticleSort::SORT_NONE && sort_period > 0 && (m_global_iteration() % sort_period) == 0) {
+    {
+      Timer::Sentry ts(m_timer_sort);
+      sortParticles(sort);
+    }
+
+    Real time = mesh()->parallelMng()->reduce(Parallel::ReduceMax, m_timer_sort->lastActivationTime());
+    info() << "--- Particle sort duration: " << time << " s ---";
+
+    ISimpleOutput* csv = ServiceBuilder<ISimpleOutput>(subDomain()).getSingleton();
+    csv->addElemRow("Sort", time);
+  }
+
   cycleFinalizeTallies();
 
   if (m_global_iteration() == options()->getNSteps())
@@ -52,6 +81,8 @@ cycleFinalize()
 void QSModule::
 endModule()
 {
+  delete (m_timer_sort);
+
   if(options()->getCsvFile() != "") {
     ISimpleOutput* csv = ServiceBuilder<ISimpleOutput>(subDomain()).getSingleton();
     csv->print();
@@ -185,8 +216,6 @@ initMesh()
     m_normal_face[iface.index()] = Real3(aa, bb, cc);
   }
 
-  m_total.resize(m_n_groups());
-  m_total.fill(0.0);
   m_cell_number_density.fill(1.0);
   m_source_tally.fill(0);
 }
@@ -309,6 +338,110 @@ cycleFinalizeTallies()
   m_end = 0;
 }
 
+/**
+ * @brief Méthode permettant de réordonner (et de compacter) la famille de
+ * particules pour que les particules d'une même maille (ou de mailles
+ * voisines) aient des localIds contigus.
+ *
+ * Les particules sont recréées dans l'ordre voulu (la famille n'a pas de
+ * table des uniqueIds, les doublons temporaires sont donc permis), toutes
+ * les variables de la famille sont copiées, puis les anciennes particules
+ * sont supprimées et la famille est compactée.
+ *
+ * @param sort L'ordre voulu.
+ */
+void QSModule::
+sortParticles(eParticleSort sort)
+{
+  IItemFamily* particle_family = mesh()->findItemFamily("ArcaneParticles");
+  ParticleVectorView particles = particle_family->view();
+  const Integer nb_particles = particles.size();
+
+  if (nb_particles == 0) {
+    return;
+  }
+
+  // Clé de tri de chaque particule.
+  Int64UniqueArray keys(nb_particles);
+
+  if (sort == eParticleSort::SORT_MORTON) {
+    // Code de Morton sur 21 bits par direction du centre de la maille.
+    const Real max_coord = (Real)((1 << 21) - 1);
+    const Real3 inv_length(max_coord / m_lx(), max_coord / m_ly(), max_coord / m_lz());
+
+    auto spread_bits = [](UInt64 x) {
+      x &= 0x1fffff;
+      x = (x | (x << 32)) & 0x1f00000000ffffULL;
+      x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+      x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+      x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+      x = (x | (x << 2)) & 0x1249249249249249ULL;
+      return x;
+    };
+    auto clamp_coord = [max_coord](Real x) {
+      return (UInt64)std::min(std::max(x, 0.0), max_coord);
+    };
+
+    arcaneParallelFor(0, nb_particles, [&](Integer begin, Integer size) {
+      for (Integer i = begin; i < (begin + size); i++) {
+        const Real3 center = m_cell_center_coord[particles[i].cell()];
+        const UInt64 x = clamp_coord(center.x * inv_length.x);
+        const UInt64 y = clamp_coord(center.y * inv_length.y);
+        const UInt64 z = clamp_coord(center.z * inv_length.z);
+        keys[i] = (Int64)(spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2));
+      }
+    });
+  }
+  else {
+    arcaneParallelFor(0, nb_particles, [&](Integer begin, Integer size) {
+      for (Integer i = begin; i < (begin + size); i++) {
+        keys[i] = particles[i].cell().localId();
+      }
+    });
+  }
+
+  // Tri stable (l'ordre relatif des particules d'une même maille est conservé).
+  Int32UniqueArray order(nb_particles);
+  for (Integer i = 0; i < nb_particles; i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](Int32 a, Int32 b) { return keys[a] < keys[b]; });
+
+  Int64UniqueArray uids(nb_particles);
+  Int32UniqueArray cells_lid(nb_particles);
+  Int32UniqueArray old_lids(nb_particles);
+  Int32UniqueArray new_lids(nb_particles);
+
+  arcaneParallelFor(0, nb_particles, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Particle particle = particles[order[i]];
+      uids[i] = particle.uniqueId().asInt64();
+      cells_lid[i] = particle.cell().localId();
+      old_lids[i] = particle.localId();
+    }
+  });
+
+  IParticleFamily* pfamily = particle_family->toParticleFamily();
+  pfamily->addParticles(uids, cells_lid, new_lids);
+  pfamily->endUpdate();
+
+  // Copie de toutes les variables de la famille.
+  VariableCollection variables;
+  particle_family->usedVariables(variables);
+  for (VariableCollection::Enumerator ivar(variables); ++ivar;) {
+    (*ivar)->copyItemsValues(old_lids, new_lids);
+  }
+
+  pfamily->removeParticles(old_lids);
+  pfamily->endUpdate();
+
+  particle_family->compactItems(false);
+
+  // TODO : A retirer lors de la correction du compactItems() dans Arcane.
+  particle_family->prepareForDump();
+}
+
 /**
  * @brief Méthode permettant de récupérer la condition aux bords de maillage.
  *
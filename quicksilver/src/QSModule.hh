@@ -11,12 +11,15 @@
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+#include <arcane/IItemFamily.h>
 #include <arcane/IMesh.h>
 #include <arcane/IParallelMng.h>
+#include <arcane/IParticleFamily.h>
 #include <arcane/ITimeLoopMng.h>
 #include <arcane/cartesianmesh/CellDirectionMng.h>
 #include <arcane/cartesianmesh/ICartesianMesh.h>
 #include <arcane/ServiceBuilder.h>
+#include <arcane/Timer.h>
 #include "ISimpleOutput.hh"
 
 #include "structEnum.hh"
@@ -37,6 +40,7 @@ public ArcaneQSObject
  public:
   explicit QSModule(const ModuleBuildInfo& mbi)
   : ArcaneQSObject(mbi)
+  , m_timer_sort(nullptr)
   {}
 
  public:
@@ -48,11 +52,13 @@ public ArcaneQSObject
 
  protected:
   ICartesianMesh* m_cartesian_mesh;
+  Timer* m_timer_sort;
 
  protected:
   void cycleFinalizeTallies();
   void initMesh();
   void initTallies();
+  void sortParticles(eParticleSort sort);
   ParticleEvent getBoundaryCondition(const Integer& pos);
 };
 
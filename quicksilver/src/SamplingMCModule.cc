@@ -13,11 +13,9 @@
 
 #include "SamplingMCModule.hh"
 #include <arcane/Concurrency.h>
-// #include <arcane/ILoadBalanceMng.h>
-// #include <arcane/IMeshPartitionerBase.h>
 #include "MC_RNG_State.hh"
+#include "ParallelScan.hh"
 #include "PhysicalConstants.hh"
-#include <map>
 #include <set>
 
 /*---------------------------------------------------------------------------*/
@@ -33,6 +31,11 @@ initModule()
   m_particle_family->setHasUniqueIdMap(false);
 
   m_timer = new Timer(subDomain(), "SamplingMC", Timer::TimerReal);
+  m_timer_source = new Timer(subDomain(), "SamplingMCSource", Timer::TimerReal);
+  m_timer_population = new Timer(subDomain(), "SamplingMCPopulation", Timer::TimerReal);
+  m_timer_flag = new Timer(subDomain(), "SamplingMCFlag", Timer::TimerReal);
+  m_timer_compaction = new Timer(subDomain(), "SamplingMCCompaction", Timer::TimerReal);
+  m_timer_update = new Timer(subDomain(), "SamplingMCUpdate", Timer::TimerReal);
 }
 
 /**
@@ -45,17 +48,28 @@ cycleInit()
   ISimpleOutput* csv = ServiceBuilder<ISimpleOutput>(subDomain()).getSingleton();
   csv->addColumn("Iteration " + String::fromNumber(m_global_iteration()));
 
+  const Real source_time_begin = m_timer_source->totalTime();
+  const Real population_time_begin = m_timer_population->totalTime();
+  const Real flag_time_begin = m_timer_flag->totalTime();
+  const Real compaction_time_begin = m_timer_compaction->totalTime();
+  const Real update_time_begin = m_timer_update->totalTime();
+
   {
     Timer::Sentry ts(m_timer);
 
-    clearCrossSectionCache();
+    clearNumParticles();
 
     m_processingView = m_particle_family->view();
     setStatus();
     m_start = m_processingView.size();
 
     // Création des particules.
-    sourceParticles();
+    {
+      Timer::Sentry tss(m_timer_source);
+      sourceParticles();
+    }
+
+    Timer::Sentry tsp(m_timer_population);
 
     // Réduction ou augmentation du nombre de particules.
     populationControl(); // controls particle population
@@ -74,7 +88,12 @@ cycleInit()
              << " - RouletteLowWeightParticles: " << m_rr_a - tmpLog
              << " particle(s) killed.";
 
+    // Suppression des particules tuées par populationControl() et
+    // rouletteLowWeightParticles().
+    removeKilledParticles();
+
     if(m_rr_a != 0){
+      Timer::Sentry tsc(m_timer_compaction);
       m_particle_family->compactItems(false);
 
       // TODO : A retirer lors de la correction du compactItems() dans Arcane.
@@ -82,20 +101,32 @@ cycleInit()
     }
 
     updateTallies();
-
-    // ENUMERATE_PARTICLE (ipartic, m_processingView) {
-    //   m_num_particles[(*ipartic).cell()]++;
-    // }
-    // ILoadBalanceMng* lb = subDomain()->loadBalanceMng();
-    // lb->addCriterion(m_num_particles);
-    // subDomain()->timeLoopMng()->registerActionMeshPartition((IMeshPartitionerBase*)options()->partitioner());
   }
 
-  Real time = mesh()->parallelMng()->reduce(Parallel::ReduceMax, m_timer->lastActivationTime());
+  IParallelMng* pm = mesh()->parallelMng();
+
+  Real time = pm->reduce(Parallel::ReduceMax, m_timer->lastActivationTime());
   info() << "--- Sampling duration: " << time << " s ---";
 
+  // Temps des phases du contrôle de population (tirages / compactions / mises
+  // à jour de la famille).
+  Real flag_time = pm->reduce(Parallel::ReduceMax, m_timer_flag->totalTime() - flag_time_begin);
+  Real compaction_time = pm->reduce(Parallel::ReduceMax, m_timer_compaction->totalTime() - compaction_time_begin);
+  Real update_time = pm->reduce(Parallel::ReduceMax, m_timer_update->totalTime() - update_time_begin);
+  info() << "--- Population control: flags " << flag_time
+         << " s / compaction " << compaction_time
+         << " s / family update " << update_time << " s ---";
+
   // On ajoute une valeur à la ligne "Sampling" (on l'a crée si elle n'existe pas).
   csv->addElemRow("Sampling", time);
+  csv->addElemRow("Sampling flags", flag_time);
+  csv->addElemRow("Sampling compaction", compaction_time);
+  csv->addElemRow("Sampling update", update_time);
+
+  // Temps de création des particules et du contrôle de population
+  // (min/max/moyenne sur les sous-domaines).
+  addMinMaxAvgRows(csv, pm, "Sampling source", m_timer_source->totalTime() - source_time_begin);
+  addMinMaxAvgRows(csv, pm, "Sampling population control", m_timer_population->totalTime() - population_time_begin);
 }
 
 /**
@@ -105,23 +136,24 @@ void SamplingMCModule::
 endModule()
 {
   delete (m_timer);
+  delete (m_timer_source);
+  delete (m_timer_population);
+  delete (m_timer_flag);
+  delete (m_timer_compaction);
+  delete (m_timer_update);
 }
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
 /**
- * @brief Méthode permettant de remettre à zéro m_total et m_num_particles.
+ * @brief Méthode permettant de remettre à zéro m_num_particles.
  */
 void SamplingMCModule::
-clearCrossSectionCache()
+clearNumParticles()
 {
   ENUMERATE_CELL (icell, ownCells()) {
     m_num_particles[icell] = 0;
-
-    for (Integer i = 0; i < m_n_groups(); i++) {
-      m_total[icell][i] = 0.0;
-    }
   }
 }
 
@@ -154,17 +186,29 @@ sourceParticles()
   Real local_weight_particles = 0;
   Real total_weight_particles = 0;
   Int64 num_particles = options()->getNParticles();
-  Int64 particle_count = 0;
 
+  CellVectorView own_cells = ownCells().view();
+  const Integer nb_own_cells = own_cells.size();
+
+  // On regarde le poids des particules que chaque cellule générera.
+  RealUniqueArray cell_weight_particles(nb_own_cells);
+  arcaneParallelFor(0, nb_own_cells, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Cell cell = own_cells[i];
   #if 1 //def QS_LEGACY_COMPATIBILITY
+      cell_weight_particles[i] = m_volume[cell] * m_source_rate[cell] * m_global_deltat();
+  #else
+      cell_weight_particles[i] = m_volume[cell] * m_source_rate[cell];
+  #endif
+    }
+  });
 
-  // On regarde le nombre de particule que chaque cellule générera.
-  ENUMERATE_CELL (icell, ownCells()) {
-    Real cell_weight_particles =
-    m_volume[icell] * m_source_rate[icell] * m_global_deltat();
-    local_weight_particles += cell_weight_particles;
+  // Somme dans l'ordre des mailles (résultat indépendant du nombre de threads).
+  for (Integer i = 0; i < nb_own_cells; i++) {
+    local_weight_particles += cell_weight_particles[i];
   }
 
+  #if 1 //def QS_LEGACY_COMPATIBILITY
 
   total_weight_particles = mesh()->parallelMng()->reduce(
   Parallel::ReduceSum, local_weight_particles);
@@ -172,88 +216,69 @@ sourceParticles()
   Real source_fraction = 0.1;
   Real source_particle_weight =
   total_weight_particles / (source_fraction * num_particles);
-  // Store the source particle weight for later use.
-  m_source_particle_weight = source_particle_weight;
-
-  // Int64UniqueArray num_particles_cells_decal(ownCells().size()+1);
-  // num_particles_cells_decal[0] = 0;
-
-  // On compte le nombre de particule total qui sera créé.
-  ENUMERATE_CELL (icell, ownCells()) {
-    // if(icell.index() != icell.localId()) ARCANE_FATAL("Trouve une autre
-    // solution");
-    Real cell_weight_particles = m_volume[icell] * m_source_rate[icell] * m_global_deltat();
-    Real cell_num_particles_float = cell_weight_particles / source_particle_weight;
-    particle_count += (Int64)cell_num_particles_float;
-    // num_particles_cells_decal[icell.localId()] = particle_count;
-  }
 
   #else
 
-  // On regarde le nombre de particule que chaque cellule générera.
-  ENUMERATE_CELL (icell, ownCells()) {
-    Real cell_weight_particles = m_volume[icell] * m_source_rate[icell];
-    local_weight_particles += cell_weight_particles;
-  }
-
   Real source_particle_weight = 1;
 
+  #endif
+
   // Store the source particle weight for later use.
   m_source_particle_weight = source_particle_weight;
 
-  particle_count = local_weight_particles;
+  // On compte le nombre de particules créées par chaque cellule puis on
+  // calcule (somme préfixe) l'indice de la première particule de chaque
+  // cellule dans les tableaux ci-dessous.
+  Int32UniqueArray cell_num_particles(nb_own_cells);
+  arcaneParallelFor(0, nb_own_cells, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Real cell_num_particles_float = cell_weight_particles[i] / source_particle_weight;
+      cell_num_particles[i] = (Integer)cell_num_particles_float;
+    }
+  });
 
-  #endif
-  
+  Int32UniqueArray cell_first_particle(nb_own_cells + 1);
+  cell_first_particle[0] = 0;
+  for (Integer i = 0; i < nb_own_cells; i++) {
+    cell_first_particle[i + 1] = cell_first_particle[i] + cell_num_particles[i];
+  }
+  const Integer particle_count = cell_first_particle[nb_own_cells];
 
   Int64UniqueArray uids(particle_count);
   Int32UniqueArray local_id_cells(particle_count);
   Int32UniqueArray particles_lid(particle_count);
-  std::map<Int64, Int64> rng;
-  Integer particle_index_g = 0;
+  // Graine de chaque future particule (même indice que particles_lid).
+  Int64UniqueArray particles_rns(particle_count);
 
-  // On gérère les uniqueId et les graines des futures particules.
-  // TODO : On a besoin d'un index global si parallélisation.
-  ENUMERATE_CELL (icell, ownCells()) {
-  #if 1 //def QS_LEGACY_COMPATIBILITY
-    Real cell_weight_particles = m_volume[icell] * m_source_rate[icell] * m_global_deltat();
-  #else
-    Real cell_weight_particles = m_volume[icell] * m_source_rate[icell];
-  #endif
-    Real cell_num_particles_float =
-    cell_weight_particles / source_particle_weight;
-    Integer cell_num_particles = (Integer)cell_num_particles_float;
-
-    // for ( Integer particle_index =
-    // num_particles_cells_decal[icell.localId()];
-    //      particle_index < num_particles_cells_decal[icell.localId()+1];
-    //      particle_index++ )
-    for (Integer particle_index = 0; particle_index < cell_num_particles;
-         particle_index++) {
-      Int64 random_number_seed;
-      Int64 rns;
-      Int64 id;
-
-      random_number_seed = m_source_tally[icell]; // TODO : Atomic
-      m_source_tally[icell]++; // TODO : Atomic
-
-      random_number_seed +=
-      (*icell).uniqueId().asInt64() * INT64_C(0x0100000000);
-
-      // La graine sera considérée comme un uint64, mais l'uniqueid doit être
-      // positif donc on change le signe en mettant le bit de poids fort à 0.
-      rns = rngSpawn_Random_Number_Seed(&random_number_seed);
-
-      id = random_number_seed;
-      id &= ~(1UL << 63);
-
-      uids[particle_index_g] = id;
-      local_id_cells[particle_index_g] = icell.localId();
-      rng[id] = rns;
-
-      particle_index_g++;
+  // On génère les uniqueId et les graines des futures particules.
+  // Chaque cellule écrit dans son propre intervalle des tableaux et ne
+  // met à jour que son m_source_tally.
+  arcaneParallelFor(0, nb_own_cells, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Cell cell = own_cells[i];
+      const Integer first_particle = cell_first_particle[i];
+
+      const Int64 first_seed = m_source_tally[cell] + cell.uniqueId().asInt64() * INT64_C(0x0100000000);
+
+      for (Integer particle_index = 0; particle_index < cell_num_particles[i];
+           particle_index++) {
+        Int64 random_number_seed = first_seed + particle_index;
+
+        // La graine sera considérée comme un uint64, mais l'uniqueid doit être
+        // positif donc on change le signe en mettant le bit de poids fort à 0.
+        Int64 rns = rngSpawn_Random_Number_Seed(&random_number_seed);
+
+        Int64 id = random_number_seed;
+        id &= ~(1UL << 63);
+
+        uids[first_particle + particle_index] = id;
+        local_id_cells[first_particle + particle_index] = cell.localId();
+        particles_rns[first_particle + particle_index] = rns;
+      }
+
+      m_source_tally[cell] += cell_num_particles[i];
     }
-  }
+  });
 
   m_particle_family->toParticleFamily()->addParticles(uids, local_id_cells,
                                                       particles_lid);
@@ -261,14 +286,14 @@ sourceParticles()
 
   VariableNodeReal3& node_coord = nodesCoordinates();
 
-  ParticleVectorView viewSrcP = m_particle_family->view(particles_lid);
-
   // Les particules sont créées, on les initialise donc.
-  arcaneParallelForeach(viewSrcP, [&](ParticleVectorView particles) {
+  arcaneParallelFor(0, particle_count, [&](Integer begin, Integer size) {
+    ParticleVectorView particles = m_particle_family->view(particles_lid.subConstView(begin, size));
+
     ENUMERATE_PARTICLE (ipartic, particles) {
       Particle p = (*ipartic);
 
-      initParticle(ipartic, rng[p.uniqueId().asInt64()]);
+      initParticle(ipartic, particles_rns[begin + ipartic.index()]);
 
       generate3DCoordinate(p, node_coord);
       sampleIsotropic(p);
@@ -288,11 +313,11 @@ sourceParticles()
 
       randomNumber = rngSample(&m_particle_rns[ipartic]);
       m_particle_time_census[ipartic] = m_global_deltat() * randomNumber;
-
-      m_source_a++;
     }
   });
 
+  m_source_a += particle_count;
+
   m_processingView = m_particle_family->view();
 }
 
@@ -300,6 +325,8 @@ sourceParticles()
  * @brief Méthode permettant de controler la quantité de particule.
  * Les particules sont splittées ou tuées selon le nombre de particule
  * ciblé.
+ * Les clones sont ajoutés en une seule mise à jour de la famille, les
+ * particules tuées sont seulement marquées dans m_kill_flags.
  */
 void SamplingMCModule::
 populationControl()
@@ -318,77 +345,111 @@ populationControl()
   // touche pas (=1).
   Real splitRRFactor = (Real)targetNumParticles / (Real)globalNumParticles;
 
-  // March backwards through the vault so killed particles doesn't mess up the
-  // indexing
+  // Les particules tuées sont marquées dans m_kill_flags (même indice que
+  // m_processingView) et supprimées par removeKilledParticles().
+  const Integer nb_particles = m_processingView.size();
+  m_kill_flags.resize(nb_particles);
+  m_kill_flags.fill(0);
+
   if (splitRRFactor == 1) {
     return;
   }
   else if (splitRRFactor < 1) {
-    Int32UniqueArray supprP;
+    Timer::Sentry ts(m_timer_flag);
 
-    arcaneParallelForeach(m_processingView, [&](ParticleVectorView particles) {
-      ENUMERATE_PARTICLE (iparticle, particles) {
-        Real randomNumber = rngSample(&m_particle_rns[iparticle]);
+    arcaneParallelFor(0, nb_particles, [&](Integer begin, Integer size) {
+      Int64 nb_killed = 0;
+      for (Integer i = begin; i < (begin + size); i++) {
+        Particle particle = m_processingView[i];
+        Real randomNumber = rngSample(&m_particle_rns[particle]);
         if (randomNumber > splitRRFactor) {
           // Kill
-          m_rr_a++;
-          GlobalMutex::ScopedLock(m_mutex);
-          supprP.add(iparticle.localId());
+          m_kill_flags[i] = 1;
+          nb_killed++;
         }
         else {
           // Ici, splitRRFactor < 1 donc on augmente la taille de la
           // particule.
-          m_particle_weight[iparticle] /= splitRRFactor;
+          m_particle_weight[particle] /= splitRRFactor;
         }
       }
+      m_rr_a += nb_killed;
     });
-    m_particle_family->toParticleFamily()->removeParticles(supprP);
-    m_particle_family->toParticleFamily()->endUpdate();
   }
 
   else if (splitRRFactor > 1) {
-    Int64UniqueArray addIdP;
-    Int64UniqueArray addRns;
-    Int32UniqueArray addCellIdP;
-    Int32UniqueArray addSrcP;
-
-    arcaneParallelForeach(m_processingView, [&](ParticleVectorView particles) {
-      ENUMERATE_PARTICLE (iparticle, particles) {
-        Particle particle = (*iparticle);
-        Real randomNumber = rngSample(&m_particle_rns[iparticle]);
-
-        // Split
-        Integer splitFactor = (Integer)floor(splitRRFactor);
-        if (randomNumber > (splitRRFactor - splitFactor)) {
-          splitFactor--;
+    // Nombre de clones de chaque particule.
+    Int32UniqueArray split_counts(nb_particles);
+    {
+      Timer::Sentry ts(m_timer_flag);
+
+      arcaneParallelFor(0, nb_particles, [&](Integer begin, Integer size) {
+        for (Integer i = begin; i < (begin + size); i++) {
+          Particle particle = m_processingView[i];
+          Real randomNumber = rngSample(&m_particle_rns[particle]);
+
+          // Split
+          Integer splitFactor = (Integer)floor(splitRRFactor);
+          if (randomNumber > (splitRRFactor - splitFactor)) {
+            splitFactor--;
+          }
+
+          m_particle_weight[particle] /= splitRRFactor;
+          split_counts[i] = splitFactor;
         }
+      });
+    }
+
+    // Indice du premier clone de chaque particule.
+    Int32UniqueArray split_offsets(nb_particles);
+    Integer nb_clones;
+    {
+      Timer::Sentry ts(m_timer_compaction);
+      nb_clones = parallelExclusiveScan(split_counts, split_offsets);
+    }
 
-        m_particle_weight[iparticle] /= splitRRFactor;
-
-        GlobalMutex::ScopedLock(m_mutex);
-        for (Integer splitFactorIndex = 0; splitFactorIndex < splitFactor;
-             splitFactorIndex++) {
-          m_split_a++;
-          Int64 rns =
-          rngSpawn_Random_Number_Seed(&m_particle_rns[iparticle]);
-          addRns.add(rns);
-          rns &= ~(1UL << 63); // On passe en positif.
-          addIdP.add(rns);
-          addCellIdP.add(particle.cell().localId());
-          addSrcP.add(iparticle.localId());
+    Int64UniqueArray addIdP(nb_clones);
+    Int64UniqueArray addRns(nb_clones);
+    Int32UniqueArray addCellIdP(nb_clones);
+    Int32UniqueArray addSrcP(nb_clones);
+    {
+      Timer::Sentry ts(m_timer_flag);
+
+      arcaneParallelFor(0, nb_particles, [&](Integer begin, Integer size) {
+        for (Integer i = begin; i < (begin + size); i++) {
+          Particle particle = m_processingView[i];
+          for (Integer splitFactorIndex = 0; splitFactorIndex < split_counts[i];
+               splitFactorIndex++) {
+            const Integer index = split_offsets[i] + splitFactorIndex;
+            Int64 rns =
+            rngSpawn_Random_Number_Seed(&m_particle_rns[particle]);
+            addRns[index] = rns;
+            rns &= ~(1UL << 63); // On passe en positif.
+            addIdP[index] = rns;
+            addCellIdP[index] = particle.cell().localId();
+            addSrcP[index] = particle.localId();
+          }
         }
-      }
-    });
+      });
+    }
+    m_split_a += nb_clones;
 
-    Int32UniqueArray particles_lid(addIdP.size());
-    m_particle_family->toParticleFamily()->addParticles(addIdP, addCellIdP,
-                                                        particles_lid);
-    m_particle_family->toParticleFamily()->endUpdate();
+    // Une seule mise à jour de la famille pour tous les clones.
+    {
+      Timer::Sentry ts(m_timer_update);
 
-    cloneParticles(addSrcP, particles_lid, addRns);
-  }
+      Int32UniqueArray particles_lid(nb_clones);
+      m_particle_family->toParticleFamily()->addParticles(addIdP, addCellIdP,
+                                                          particles_lid);
+      m_particle_family->toParticleFamily()->endUpdate();
 
-  m_processingView = m_particle_family->view();
+      cloneParticles(addSrcP, particles_lid, addRns);
+    }
+
+    m_processingView = m_particle_family->view();
+    m_kill_flags.resize(m_processingView.size());
+    m_kill_flags.fill(0);
+  }
 }
 
 /**
@@ -440,16 +501,18 @@ initParticle(ParticleEnumerator p, const Int64& rns)
  * @param rnsNew Tableau contenant les graines à donner aux particules.
  */
 void SamplingMCModule::
-cloneParticles(Int32UniqueArray idsSrc,
-               Int32UniqueArray idsNew,
-               Int64UniqueArray rnsNew)
+cloneParticles(ConstArrayView<Int32> idsSrc,
+               ConstArrayView<Int32> idsNew,
+               ConstArrayView<Int64> rnsNew)
 {
   ParticleVectorView viewSrcP = m_particle_family->view(idsSrc);
   ParticleVectorView viewNewP = m_particle_family->view(idsNew);
-  ENUMERATE_PARTICLE (iparticle, viewSrcP) {
-    Particle pNew(viewNewP[iparticle.index()].internal());
-    cloneParticle((*iparticle), pNew, rnsNew[iparticle.index()]);
-  }
+
+  arcaneParallelFor(0, viewSrcP.size(), [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      cloneParticle(viewSrcP[i], viewNewP[i], rnsNew[i]);
+    }
+  });
 }
 
 /**
@@ -497,6 +560,7 @@ cloneParticle(Particle pSrc, Particle pNew, const Int64& rns)
 /**
  * @brief Méthode permettant de tuer (aléatoirement) les particules trop
  * petites. Roulette russe.
+ * Les particules tuées sont seulement marquées dans m_kill_flags.
  */
 void SamplingMCModule::
 rouletteLowWeightParticles()
@@ -504,35 +568,59 @@ rouletteLowWeightParticles()
   const Real lowWeightCutoff = options()->getLowWeightCutoff();
 
   if (lowWeightCutoff > 0.0) {
-    Int32UniqueArray supprP;
+    Timer::Sentry ts(m_timer_flag);
 
-    // March backwards through the vault so killed particles don't mess up the
-    // indexing
     const Real weightCutoff = lowWeightCutoff * m_source_particle_weight;
 
-    arcaneParallelForeach(m_processingView, [&](ParticleVectorView particles) {
-      ENUMERATE_PARTICLE (iparticle, particles) {
-        if (m_particle_weight[iparticle] <= weightCutoff) {
-          Real randomNumber = rngSample(&m_particle_rns[iparticle]);
+    arcaneParallelFor(0, m_processingView.size(), [&](Integer begin, Integer size) {
+      Int64 nb_killed = 0;
+      for (Integer i = begin; i < (begin + size); i++) {
+        // Particule déjà tuée par populationControl().
+        if (m_kill_flags[i] != 0) {
+          continue;
+        }
+        Particle particle = m_processingView[i];
+        if (m_particle_weight[particle] <= weightCutoff) {
+          Real randomNumber = rngSample(&m_particle_rns[particle]);
           if (randomNumber <= lowWeightCutoff) {
             // The particle history continues with an increased weight.
-            m_particle_weight[iparticle] /= lowWeightCutoff;
+            m_particle_weight[particle] /= lowWeightCutoff;
           }
           else {
             // Kill
-            m_rr_a++;
-            GlobalMutex::ScopedLock(m_mutex);
-            supprP.add(iparticle.localId());
+            m_kill_flags[i] = 1;
+            nb_killed++;
           }
         }
       }
+      m_rr_a += nb_killed;
     });
+  }
+}
+
+/**
+ * @brief Méthode permettant de supprimer les particules marquées dans
+ * m_kill_flags (par populationControl() et rouletteLowWeightParticles())
+ * en une seule mise à jour de la famille.
+ */
+void SamplingMCModule::
+removeKilledParticles()
+{
+  Int32UniqueArray killed_lids;
+  {
+    Timer::Sentry ts(m_timer_compaction);
+    parallelCompact(m_kill_flags, m_processingView.localIds(), killed_lids);
+  }
 
-    m_particle_family->toParticleFamily()->removeParticles(supprP);
+  if (!killed_lids.empty()) {
+    Timer::Sentry ts(m_timer_update);
+
+    m_particle_family->toParticleFamily()->removeParticles(killed_lids);
     m_particle_family->toParticleFamily()->endUpdate();
 
     m_processingView = m_particle_family->view();
   }
+  m_kill_flags.clear();
 }
 
 /**
@@ -621,9 +709,11 @@ generate3DCoordinate(Particle p, VariableNodeReal3& node_coord)
 #endif
 
   // Sample from the tet.
-  Real r1 = rngSample(random_number_seed);
-  Real r2 = rngSample(random_number_seed);
-  Real r3 = rngSample(random_number_seed);
+  Real random_numbers[3];
+  rngSampleN(random_number_seed, 3, random_numbers);
+  Real r1 = random_numbers[0];
+  Real r2 = random_numbers[1];
+  Real r3 = random_numbers[2];
 
   // Cut and fold cube into prism.
   if (r1 + r2 > 1.0) {
@@ -697,11 +787,14 @@ computeTetVolume(const Real3& v0_,
 void SamplingMCModule::
 sampleIsotropic(Particle p)
 {
-  m_particle_dir_cos[p][MD_DirG] = 1.0 - 2.0 * rngSample(&m_particle_rns[p]);
+  Real random_numbers[2];
+  rngSampleN(&m_particle_rns[p], 2, random_numbers);
+
+  m_particle_dir_cos[p][MD_DirG] = 1.0 - 2.0 * random_numbers[0];
   Real sine_gamma = sqrt((
   1.0 - (m_particle_dir_cos[p][MD_DirG] * m_particle_dir_cos[p][MD_DirG])));
   Real phi =
-  PhysicalConstants::_pi * (2.0 * rngSample(&m_particle_rns[p]) - 1.0);
+  PhysicalConstants::_pi * (2.0 * random_numbers[1] - 1.0);
 
   m_particle_dir_cos[p][MD_DirA] = sine_gamma * cos(phi);
   m_particle_dir_cos[p][MD_DirB] = sine_gamma * sin(phi);
@@ -21,6 +21,7 @@
 #include <arcane/materials/MeshMaterialVariableRef.h>
 #include <arccore/concurrency/Mutex.h>
 #include "ISimpleOutput.hh"
+#include "PerfStats.hh"
 #include <arcane/ServiceBuilder.h>
 
 #include "SamplingMC_axl.h"
@@ -38,6 +39,11 @@ class SamplingMCModule : public ArcaneSamplingMCObject
   : ArcaneSamplingMCObject(mbi)
   , m_particle_family(nullptr)
   , m_timer(nullptr)
+  , m_timer_source(nullptr)
+  , m_timer_population(nullptr)
+  , m_timer_flag(nullptr)
+  , m_timer_compaction(nullptr)
+  , m_timer_update(nullptr)
   {}
 
  public:
@@ -56,21 +62,29 @@ class SamplingMCModule : public ArcaneSamplingMCObject
   std::atomic<Int64> m_rr_a{ 0 };
   std::atomic<Int64> m_split_a{ 0 };
 
-  GlobalMutex m_mutex;
+  // Particules à supprimer (même indice que m_processingView).
+  Int32UniqueArray m_kill_flags;
 
   Timer* m_timer;
+  Timer* m_timer_source;
+  Timer* m_timer_population;
+  // Temps des phases du contrôle de population.
+  Timer* m_timer_flag;
+  Timer* m_timer_compaction;
+  Timer* m_timer_update;
 
  protected:
   void updateTallies();
-  void clearCrossSectionCache();
+  void clearNumParticles();
   void setStatus();
   void sourceParticles();
   void populationControl();
   void initParticle(ParticleEnumerator p, const Int64& rns);
-  void cloneParticles(Int32UniqueArray idsSrc, Int32UniqueArray idsNew, Int64UniqueArray rnsNew);
+  void cloneParticles(ConstArrayView<Int32> idsSrc, ConstArrayView<Int32> idsNew, ConstArrayView<Int64> rnsNew);
   void cloneParticle(Particle pSrc, Particle pNew, const Int64& rns);
   Real computeTetVolume(const Real3& v0_, const Real3& v1_, const Real3& v2_, const Real3& v3);
   void rouletteLowWeightParticles();
+  void removeKilledParticles();
   void generate3DCoordinate(Particle p, VariableNodeReal3& node_coord);
   void sampleIsotropic(Particle p);
   Real getSpeedFromEnergy(Particle p);
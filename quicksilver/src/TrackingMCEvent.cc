@@ -0,0 +1,562 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* TrackingMCEvent.cc                                          (C) 2000-2022 */
+/*                                                                           */
+/* Moteur de tracking par événements QAMA                                    */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "TrackingMCModule.hh"
+#include "MC_RNG_State.hh"
+#include "PhysicalConstants.hh"
+#include <arcane/Concurrency.h>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Méthode permettant de suivre un ensemble de particules par événements.
+ * Au lieu de suivre une particule jusqu'à la fin de son itération, on
+ * calcule le prochain événement de toutes les particules actives, on les
+ * regroupe par type d'événement puis on traite chaque lot.
+ * Les grandeurs des particules sont copiées dans m_soa le temps du suivi.
+ * Les particules sortent de la liste active dans les mêmes cas que dans
+ * cycleTrackingFunction() (census, absorption, split, sortie, changement
+ * de sous-domaine).
+ *
+ * @param particles Les particules à suivre.
+ * @param node_coord Les coordonnées des nodes.
+ */
+void TrackingMCModule::
+trackingEventBased(ParticleVectorView particles, VariableNodeReal3& node_coord)
+{
+  m_cells_internal = mesh()->itemsInternal(IK_Cell);
+
+  loadParticleSoA(particles);
+
+  Integer nb_particle = m_soa.size();
+
+  Int32Array& active = m_soa.active;
+  Int32Array& census_batch = m_soa.census_batch;
+  Int32Array& collision_batch = m_soa.collision_batch;
+  Int32Array& facet_batch = m_soa.facet_batch;
+
+  active.resize(nb_particle);
+  for (Integer i = 0; i < nb_particle; i++) {
+    active[i] = i;
+  }
+
+  while (!active.empty()) {
+    computeNextEventBatch(active, node_coord);
+
+    m_counters.local().num_segments += active.size();
+
+    census_batch.clear();
+    collision_batch.clear();
+    facet_batch.clear();
+
+    for (Integer idx : active) {
+      m_soa.num_seg[idx] += 1.;
+      if (m_use_segment_criterion) {
+        m_cell_work.add(m_soa.cell_id[idx]);
+      }
+
+      switch (m_soa.last_event[idx]) {
+      case ParticleEvent::collision:
+        collision_batch.add(idx);
+        break;
+      case ParticleEvent::faceEventUndefined:
+        facet_batch.add(idx);
+        break;
+      case ParticleEvent::census:
+        census_batch.add(idx);
+        break;
+      default:
+        ARCANE_ASSERT(false, "Evenement particle inconnu");
+        break;
+      }
+    }
+
+    active.clear();
+
+    censusEventBatch(census_batch);
+    collisionEventBatch(collision_batch, active);
+    facetCrossingEventBatch(facet_batch, active);
+  }
+
+  storeParticleSoA(particles);
+}
+
+/**
+ * @brief Méthode permettant de copier les grandeurs des particules dans m_soa.
+ * On fait aussi l'initialisation effectuée par cycleTrackingGuts().
+ *
+ * @param particles Les particules à copier.
+ */
+void TrackingMCModule::
+loadParticleSoA(ParticleVectorView particles)
+{
+  m_soa.resize(particles.size());
+  m_soa.reserveScratch(particles.size());
+
+  arcaneParallelFor(0, particles.size(), [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Particle particle(particles[i].internal());
+
+      if (m_particle_status[particle] == ParticleState::exitedParticle || m_particle_status[particle] == ParticleState::censusParticle) {
+        ARCANE_FATAL("Particule déjà traitée.");
+      }
+
+      if (m_particle_time_census[particle] <= 0.0) {
+        m_particle_time_census[particle] += m_global_deltat();
+      }
+
+      if (m_particle_age[particle] < 0.0) {
+        m_particle_age[particle] = 0.0;
+      }
+
+      m_soa.local_id[i] = particle.localId();
+      m_soa.cell_id[i] = particle.cell().localId();
+
+      m_soa.coord_x[i] = m_particle_coord[particle][MD_DirX];
+      m_soa.coord_y[i] = m_particle_coord[particle][MD_DirY];
+      m_soa.coord_z[i] = m_particle_coord[particle][MD_DirZ];
+
+      m_soa.velocity_x[i] = m_particle_velocity[particle][MD_DirX];
+      m_soa.velocity_y[i] = m_particle_velocity[particle][MD_DirY];
+      m_soa.velocity_z[i] = m_particle_velocity[particle][MD_DirZ];
+
+      m_soa.dir_cos_a[i] = m_particle_dir_cos[particle][MD_DirA];
+      m_soa.dir_cos_b[i] = m_particle_dir_cos[particle][MD_DirB];
+      m_soa.dir_cos_g[i] = m_particle_dir_cos[particle][MD_DirG];
+
+      m_soa.kin_ene[i] = m_particle_kin_ene[particle];
+      m_soa.weight[i] = m_particle_weight[particle];
+      m_soa.time_census[i] = m_particle_time_census[particle];
+      m_soa.total_cross_section[i] = m_particle_total_cross_section[particle];
+      m_soa.age[i] = m_particle_age[particle];
+      m_soa.num_mean_free_path[i] = m_particle_num_mean_free_path[particle];
+      m_soa.mean_free_path[i] = m_particle_mean_free_path[particle];
+      m_soa.seg_path_length[i] = m_particle_seg_path_length[particle];
+      m_soa.num_seg[i] = m_particle_num_seg[particle];
+
+      m_soa.rns[i] = m_particle_rns[particle];
+
+      m_soa.last_event[i] = m_particle_last_event[particle];
+      m_soa.status[i] = m_particle_status[particle];
+      m_soa.ene_grp[i] = m_nuclearData->getEnergyGroup(m_soa.kin_ene[i]);
+      m_soa.face[i] = m_particle_face[particle];
+      m_soa.facet[i] = m_particle_facet[particle];
+    }
+  });
+}
+
+/**
+ * @brief Méthode permettant de recopier m_soa dans les variables des particules.
+ * Le changement de maille est fait ici (setParticleCell() n'est pas thread-safe).
+ *
+ * @param particles Les particules à mettre à jour (même ordre qu'au chargement).
+ */
+void TrackingMCModule::
+storeParticleSoA(ParticleVectorView particles)
+{
+  arcaneParallelFor(0, particles.size(), [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Particle particle(particles[i].internal());
+
+      m_particle_coord[particle] = Real3(m_soa.coord_x[i], m_soa.coord_y[i], m_soa.coord_z[i]);
+      m_particle_velocity[particle] = Real3(m_soa.velocity_x[i], m_soa.velocity_y[i], m_soa.velocity_z[i]);
+      m_particle_dir_cos[particle] = Real3(m_soa.dir_cos_a[i], m_soa.dir_cos_b[i], m_soa.dir_cos_g[i]);
+
+      m_particle_kin_ene[particle] = m_soa.kin_ene[i];
+      m_particle_weight[particle] = m_soa.weight[i];
+      m_particle_time_census[particle] = m_soa.time_census[i];
+      m_particle_total_cross_section[particle] = m_soa.total_cross_section[i];
+      m_particle_age[particle] = m_soa.age[i];
+      m_particle_num_mean_free_path[particle] = m_soa.num_mean_free_path[i];
+      m_particle_mean_free_path[particle] = m_soa.mean_free_path[i];
+      m_particle_seg_path_length[particle] = m_soa.seg_path_length[i];
+      m_particle_num_seg[particle] = m_soa.num_seg[i];
+
+      m_particle_rns[particle] = m_soa.rns[i];
+
+      m_particle_last_event[particle] = m_soa.last_event[i];
+      m_particle_status[particle] = m_soa.status[i];
+      m_particle_ene_grp[particle] = m_soa.ene_grp[i];
+      m_particle_face[particle] = m_soa.face[i];
+      m_particle_facet[particle] = m_soa.facet[i];
+    }
+  });
+
+  IParticleFamily* particle_family = m_particle_family->toParticleFamily();
+  for (Integer i = 0; i < particles.size(); i++) {
+    Particle particle(particles[i].internal());
+    if (particle.cell().localId() != m_soa.cell_id[i]) {
+      particle_family->setParticleCell(particle, Cell(m_cells_internal[m_soa.cell_id[i]]));
+    }
+  }
+}
+
+/**
+ * @brief Méthode permettant de trouver le prochain événement d'un lot de
+ * particules. Equivalent de computeNextEvent() sur m_soa.
+ * Les données des mailles sont lues dans des tableaux indexés par localId
+ * (densité, matériau, sections efficaces de m_cross_section_table et
+ * facets de m_facet_geometry).
+ *
+ * @param batch Les positions des particules dans m_soa.
+ * @param node_coord Les coordonnées des nodes.
+ */
+void TrackingMCModule::
+computeNextEventBatch(ConstArrayView<Int32> batch, VariableNodeReal3& node_coord)
+{
+  ConstArrayView<Real> cell_number_density = m_cell_number_density.asArray();
+  ConstArrayView<Int32> cell_material_index = m_cell_material_index.asArray();
+
+  arcaneParallelFor(0, batch.size(), m_tracking_loop_options, [&](Integer begin, Integer size) {
+    const Real begin_time = platform::getRealTime();
+    for (Integer i = begin; i < (begin + size); i++) {
+      const Int32 idx = batch[i];
+      const Int32 cell_lid = m_soa.cell_id[idx];
+
+      Real3 velocity(m_soa.velocity_x[idx], m_soa.velocity_y[idx], m_soa.velocity_z[idx]);
+      Real particle_speed = velocity.normL2();
+
+      // Force collision if a census event narrowly preempts a collision
+      bool force_collision = false;
+      if (m_soa.num_mean_free_path[idx] < 0.0) {
+        force_collision = true;
+        m_soa.num_mean_free_path[idx] = PhysicalConstants::_smallDouble;
+      }
+
+      Real macroscopic_total_cross_section = weightedMacroscopicCrossSection(cell_number_density[cell_lid], cell_material_index[cell_lid], m_soa.ene_grp[idx]);
+
+      m_soa.total_cross_section[idx] = macroscopic_total_cross_section;
+      if (macroscopic_total_cross_section == 0.0) {
+        m_soa.mean_free_path[idx] = PhysicalConstants::_hugeDouble;
+      }
+      else {
+        m_soa.mean_free_path[idx] = 1.0 / macroscopic_total_cross_section;
+      }
+
+      if (m_soa.num_mean_free_path[idx] == 0.0) {
+        Real random_number = rngSample(&m_soa.rns[idx]);
+        m_soa.num_mean_free_path[idx] = -1.0 * std::log(random_number);
+      }
+
+      if (force_collision) {
+        m_soa.seg_path_length[idx] = PhysicalConstants::_tinyDouble;
+        m_soa.last_event[idx] = ParticleEvent::collision;
+        m_soa.num_mean_free_path[idx] = 0.0;
+      }
+
+      else {
+        Real3 coord(m_soa.coord_x[idx], m_soa.coord_y[idx], m_soa.coord_z[idx]);
+        Real3 dir_cos(m_soa.dir_cos_a[idx], m_soa.dir_cos_b[idx], m_soa.dir_cos_g[idx]);
+
+        DistanceToFacet nearest_facet = getNearestFacet(cell_lid, coord, dir_cos, m_soa.num_seg[idx], node_coord);
+
+        // La particule a pu être déplacée par findNearestFacet().
+        m_soa.coord_x[idx] = coord[MD_DirX];
+        m_soa.coord_y[idx] = coord[MD_DirY];
+        m_soa.coord_z[idx] = coord[MD_DirZ];
+
+        if (m_soa.last_event[idx] == ParticleEvent::faceEventUndefined) {
+          continue;
+        }
+
+        // Même ordre que dans computeNextEvent() : collision, census, faceEventUndefined.
+        Real distance[3];
+        distance[ParticleEvent::collision] = m_soa.num_mean_free_path[idx] * m_soa.mean_free_path[idx];
+        distance[ParticleEvent::census] = particle_speed * m_soa.time_census[idx];
+        distance[ParticleEvent::faceEventUndefined] = nearest_facet.distance;
+
+        Integer segment_outcome = 0;
+        for (Integer event = 1; event < 3; event++) {
+          if (distance[event] < distance[segment_outcome]) {
+            segment_outcome = event;
+          }
+        }
+
+        m_soa.seg_path_length[idx] = distance[segment_outcome];
+        m_soa.last_event[idx] = segment_outcome;
+
+        if (segment_outcome == ParticleEvent::collision) {
+          m_soa.num_mean_free_path[idx] = 0.0;
+        }
+        else {
+          m_soa.num_mean_free_path[idx] -= m_soa.seg_path_length[idx] / m_soa.mean_free_path[idx];
+        }
+
+        if (segment_outcome == ParticleEvent::faceEventUndefined) {
+          m_soa.face[idx] = nearest_facet.facet / 4;
+          m_soa.facet[idx] = nearest_facet.facet % 4;
+        }
+
+        else if (segment_outcome == ParticleEvent::census) {
+          m_soa.time_census[idx] = std::min(m_soa.time_census[idx], 0.0);
+        }
+
+        if (m_soa.seg_path_length[idx] == 0.0) {
+          continue;
+        }
+      }
+
+      const Real seg_path_length = m_soa.seg_path_length[idx];
+
+      m_soa.coord_x[idx] += m_soa.dir_cos_a[idx] * seg_path_length;
+      m_soa.coord_y[idx] += m_soa.dir_cos_b[idx] * seg_path_length;
+      m_soa.coord_z[idx] += m_soa.dir_cos_g[idx] * seg_path_length;
+
+      Real segment_path_time = (seg_path_length / particle_speed);
+
+      m_soa.time_census[idx] -= segment_path_time;
+      m_soa.age[idx] += segment_path_time;
+
+      if (m_soa.time_census[idx] < 0.0) {
+        m_soa.time_census[idx] = 0.0;
+      }
+
+      m_flux_tally.add(m_soa.cell_id[idx], m_soa.ene_grp[idx], seg_path_length * m_soa.weight[idx]);
+    }
+    m_thread_loads.local().addBatch(size, begin_time);
+  });
+}
+
+/**
+ * @brief Méthode permettant de traiter un lot de particules ayant fini leur itération.
+ *
+ * @param batch Les positions des particules dans m_soa.
+ */
+void TrackingMCModule::
+censusEventBatch(ConstArrayView<Int32> batch)
+{
+  for (Integer idx : batch) {
+    m_soa.status[idx] = ParticleState::censusParticle;
+  }
+  m_counters.local().census += batch.size();
+}
+
+/**
+ * @brief Méthode permettant de traiter un lot de collisions.
+ * Equivalent de collisionEvent() sur m_soa : la partie aléatoire est faite en
+ * parallèle, le classement des particules (absorbées, déviées, splittées)
+ * est fait ensuite de manière séquentielle.
+ *
+ * @param batch Les positions des particules dans m_soa.
+ * @param active Les particules qui doivent continuer leur suivi (en sortie).
+ */
+void TrackingMCModule::
+collisionEventBatch(ConstArrayView<Int32> batch, Int32Array& active)
+{
+  const Integer nb_collision = batch.size();
+  if (nb_collision == 0) {
+    return;
+  }
+
+  const Integer max_production_size = options()->getMax_production_size();
+
+  // Tableaux conservés d'un lot à l'autre : ils ne sont réalloués que si
+  // ce lot de collisions est plus grand que tous les précédents.
+  RealArray& energy_out = m_soa.energy_out;
+  RealArray& angle_out = m_soa.angle_out;
+  Int64Array& child_rns = m_soa.child_rns;
+  Int32Array& n_out = m_soa.n_out;
+  Int32Array& reaction_type = m_soa.reaction_type;
+
+  energy_out.resize(nb_collision * max_production_size);
+  angle_out.resize(nb_collision * max_production_size);
+  child_rns.resize(nb_collision * max_production_size);
+  n_out.resize(nb_collision);
+  reaction_type.resize(nb_collision);
+
+  ConstArrayView<Int32> cell_material_index = m_cell_material_index.asArray();
+  ConstArrayView<Real> cell_mass = m_mass.globalVariable().asArray();
+
+  arcaneParallelFor(0, nb_collision, m_tracking_loop_options, [&](Integer begin, Integer size) {
+    const Real begin_time = platform::getRealTime();
+    for (Integer i = begin; i < (begin + size); i++) {
+      const Int32 idx = batch[i];
+      const Int32 cell_lid = m_soa.cell_id[idx];
+
+      NuclearDataReaction& reaction = sampleReaction(cell_material_index[cell_lid], m_soa.ene_grp[idx], &m_soa.rns[idx]);
+
+      ArrayView<Real> energy_out_av = energy_out.subView(i * max_production_size, max_production_size);
+      ArrayView<Real> angle_out_av = angle_out.subView(i * max_production_size, max_production_size);
+      Integer nOut = 0;
+
+      reaction.sampleCollision(m_soa.kin_ene[idx], cell_mass[cell_lid], energy_out_av, angle_out_av, nOut,
+                               &m_soa.rns[idx], max_production_size);
+
+      n_out[i] = nOut;
+      reaction_type[i] = reaction._reactionType;
+
+      if (nOut == 1) {
+        Real3 dir_cos(m_soa.dir_cos_a[idx], m_soa.dir_cos_b[idx], m_soa.dir_cos_g[idx]);
+        Real3 velocity;
+
+        updateTrajectory(energy_out_av[0], angle_out_av[0], m_soa.kin_ene[idx], dir_cos,
+                         velocity, m_soa.num_mean_free_path[idx], &m_soa.rns[idx]);
+
+        m_soa.dir_cos_a[idx] = dir_cos[MD_DirA];
+        m_soa.dir_cos_b[idx] = dir_cos[MD_DirB];
+        m_soa.dir_cos_g[idx] = dir_cos[MD_DirG];
+        m_soa.velocity_x[idx] = velocity[MD_DirX];
+        m_soa.velocity_y[idx] = velocity[MD_DirY];
+        m_soa.velocity_z[idx] = velocity[MD_DirZ];
+
+        m_soa.ene_grp[idx] = m_nuclearData->getEnergyGroup(m_soa.kin_ene[idx]);
+      }
+
+      // Les graines des clones sont tirées ici pour garder la même séquence
+      // aléatoire que collisionEvent().
+      else if (nOut > 1) {
+        for (Integer j = 1; j < nOut; j++) {
+          child_rns[i * max_production_size + j] = rngSpawn_Random_Number_Seed(&m_soa.rns[idx]);
+        }
+      }
+    }
+    m_thread_loads.local().addBatch(size, begin_time);
+  });
+
+  TrackingEventCounters& counters = m_counters.local();
+  counters.collision += nb_collision;
+
+  CollisionStaging& staging = m_collision_staging.local();
+
+  for (Integer i = 0; i < nb_collision; i++) {
+    const Int32 idx = batch[i];
+    const Integer nOut = n_out[i];
+
+#ifdef QS_LEGACY_COMPATIBILITY
+    switch (reaction_type[i]) {
+    case NuclearDataReaction::Absorption:
+      counters.absorb++;
+      break;
+    case NuclearDataReaction::Scatter:
+      counters.scatter++;
+      break;
+    case NuclearDataReaction::Fission:
+      counters.fission++;
+      counters.produce += nOut;
+      break;
+    default:
+      ARCANE_ASSERT(false, "reactionType invalid");
+    }
+#endif
+
+    // La particule est absorbée.
+    if (nOut == 0) {
+#ifndef QS_LEGACY_COMPATIBILITY
+      counters.absorb++;
+#endif
+      m_soa.status[idx] = ParticleState::exitedParticle;
+      m_exited_particles_local_ids.add(m_soa.local_id[idx]);
+    }
+
+    // La particule a juste changée de trajectoire.
+    else if (nOut == 1) {
+#ifndef QS_LEGACY_COMPATIBILITY
+      counters.scatter++;
+#endif
+      active.add(idx);
+    }
+
+    // La particule splitte, les clones seront créés par collisionEventSuite().
+    else {
+#ifndef QS_LEGACY_COMPATIBILITY
+      counters.fission++;
+      counters.produce += nOut;
+#endif
+      for (Integer j = 1; j < nOut; j++) {
+        const Integer pos = i * max_production_size + j;
+        staging.secondaries.add(SecondaryParticle{ child_rns[pos], m_soa.cell_id[idx], m_soa.local_id[idx], energy_out[pos], angle_out[pos] });
+      }
+
+      staging.sources.add(SplitParticle{ m_soa.local_id[idx], energy_out[i * max_production_size], angle_out[i * max_production_size] });
+    }
+  }
+}
+
+/**
+ * @brief Méthode permettant de traiter un lot de particules arrivées sur une face.
+ * Equivalent de facetCrossingEvent() et reflectParticle() sur m_soa.
+ *
+ * @param batch Les positions des particules dans m_soa.
+ * @param active Les particules qui doivent continuer leur suivi (en sortie).
+ */
+void TrackingMCModule::
+facetCrossingEventBatch(ConstArrayView<Int32> batch, Int32Array& active)
+{
+  arcaneParallelFor(0, batch.size(), m_tracking_loop_options, [&](Integer begin, Integer size) {
+    const Real begin_time = platform::getRealTime();
+    for (Integer i = begin; i < (begin + size); i++) {
+      const Int32 idx = batch[i];
+      Cell cell(m_cells_internal[m_soa.cell_id[idx]]);
+      Face face = cell.face(m_soa.face[idx]);
+
+      m_soa.last_event[idx] = m_boundary_cond[face];
+
+      if (m_soa.last_event[idx] == ParticleEvent::cellChange) {
+        Cell new_cell = face.frontCell();
+
+        if (new_cell == cell) {
+          new_cell = face.backCell();
+        }
+
+        m_soa.cell_id[idx] = new_cell.localId();
+
+        if (face.frontCell().owner() != face.backCell().owner()) {
+          m_soa.last_event[idx] = ParticleEvent::subDChange;
+        }
+      }
+
+      else if (m_soa.last_event[idx] == ParticleEvent::reflection) {
+        Real3 dir_cos(m_soa.dir_cos_a[idx], m_soa.dir_cos_b[idx], m_soa.dir_cos_g[idx]);
+        Real3 velocity(m_soa.velocity_x[idx], m_soa.velocity_y[idx], m_soa.velocity_z[idx]);
+
+        reflectParticle(m_soa.face[idx], dir_cos, velocity);
+
+        m_soa.dir_cos_a[idx] = dir_cos[MD_DirA];
+        m_soa.dir_cos_b[idx] = dir_cos[MD_DirB];
+        m_soa.dir_cos_g[idx] = dir_cos[MD_DirG];
+        m_soa.velocity_x[idx] = velocity[MD_DirX];
+        m_soa.velocity_y[idx] = velocity[MD_DirY];
+        m_soa.velocity_z[idx] = velocity[MD_DirZ];
+      }
+    }
+    m_thread_loads.local().addBatch(size, begin_time);
+  });
+
+  TrackingEventCounters& counters = m_counters.local();
+
+  for (Integer idx : batch) {
+    switch (m_soa.last_event[idx]) {
+    case ParticleEvent::cellChange:
+    case ParticleEvent::reflection:
+      active.add(idx);
+      break;
+
+    case ParticleEvent::escape:
+      counters.escape++;
+      m_soa.status[idx] = ParticleState::exitedParticle;
+      m_exited_particles_local_ids.add(m_soa.local_id[idx]);
+      break;
+
+    default:
+      // Enters an adjacent cell in an off-processor domain.
+      // Pas de m_exited_particles_local_ids car la particle sera retirée de la famille par ExchangeParticles.
+      m_outgoing_particles_local_ids.add(m_soa.local_id[idx]);
+      m_outgoing_particles_rank_to.add(Cell(m_cells_internal[m_soa.cell_id[idx]]).owner());
+      break;
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -15,7 +15,9 @@
 #include "MC_RNG_State.hh"
 #include "PhysicalConstants.hh"
 #include <arcane/Concurrency.h>
+#include <arcane/utils/PlatformUtils.h>
 #include <map>
+#include <numeric>
 #include <set>
 
 /*---------------------------------------------------------------------------*/
@@ -36,9 +38,42 @@ initModule()
   pe->initialize(m_particle_family);
 
   m_timer = new Timer(subDomain(), "TrackingMC", Timer::TimerReal);
+  m_timer_compute = new Timer(subDomain(), "TrackingMCCompute", Timer::TimerReal);
+  m_timer_exchange = new Timer(subDomain(), "TrackingMCExchange", Timer::TimerReal);
+  m_timer_update = new Timer(subDomain(), "TrackingMCUpdate", Timer::TimerReal);
+  m_timer_compaction = new Timer(subDomain(), "TrackingMCCompaction", Timer::TimerReal);
+
+  m_counters.init();
+  m_thread_loads.init();
+  if (options()->getTrackingGrainSize() > 0) {
+    m_tracking_loop_options.setGrainSize(options()->getTrackingGrainSize());
+  }
+  // Le moteur event traite les particules par lots d'événements : l'ordre
+  // de départ des particules n'a pas d'effet.
+  if (options()->getTrackingCostSort() && options()->getTrackingEngine() == eTrackingEngine::EVENT) {
+    warning() << "trackingCostSort n'est pas utilisé par le moteur de tracking event";
+  }
+  m_collision_staging.init(options()->getMax_production_size(), 1024);
+  m_flux_tally.init(mesh()->cellFamily()->maxLocalId(), m_n_groups(), options()->getFluxTallyMode());
+
+  // Le nombre de segments suivis par maille est donné comme critère au
+  // gestionnaire d'équilibrage (utilisé par le module ArcaneLoadBalance).
+  m_use_segment_criterion = options()->getSegmentLoadBalance();
+  if (m_use_segment_criterion) {
+    m_cell_work.init(mesh()->cellFamily()->maxLocalId());
+    m_cell_segments.fill(1.0);
+    subDomain()->loadBalanceMng()->addCriterion(m_cell_segments);
+  }
 
   // Configuration des materiaux.
   initNuclearData();
+
+  // Le moteur event lit toujours les facets dans les tableaux précalculés.
+  m_use_facet_geometry = (options()->getGeometryEngine() == eGeometryEngine::PACKED ||
+                          options()->getTrackingEngine() == eTrackingEngine::EVENT);
+  if (m_use_facet_geometry) {
+    initFacetGeometry();
+  }
 }
 
 /**
@@ -47,26 +82,152 @@ initModule()
 void TrackingMCModule::
 cycleTracking()
 {
+  const Real compute_time_begin = m_timer_compute->totalTime();
+  const Real exchange_time_begin = m_timer_exchange->totalTime();
+  const Real update_time_begin = m_timer_update->totalTime();
+  const Real compaction_time_begin = m_timer_compaction->totalTime();
+
   {
     Timer::Sentry ts(m_timer);
-    computeCrossSection();
     tracking();
-    
-    if(m_absorb_a != 0 || m_escape_a != 0){
+    updateTallies();
+
+    if (m_use_segment_criterion) {
+      m_cell_work.flush(m_cell_segments, ownCells());
+    }
+
+    if (m_absorb() != 0 || m_escape() != 0) {
+      Timer::Sentry tsc(m_timer_compaction);
       m_particle_family->compactItems(false);
 
       // TODO : A retirer lors de la correction du compactItems() dans Arcane.
       m_particle_family->prepareForDump();
     }
-
-    updateTallies();
   }
 
-  Real time = mesh()->parallelMng()->reduce(Parallel::ReduceMax, m_timer->lastActivationTime());
+  IParallelMng* pm = mesh()->parallelMng();
+
+  Real time = pm->reduce(Parallel::ReduceMax, m_timer->lastActivationTime());
   info() << "--- Tracking duration: " << time << " s ---";
 
   ISimpleOutput* csv = ServiceBuilder<ISimpleOutput>(subDomain()).getSingleton();
   csv->addElemRow("Tracking", time);
+
+  // Temps des phases du tracking (min/max/moyenne sur les sous-domaines).
+  Real compute_time = addMinMaxAvgRows(csv, pm, "Tracking compute", m_timer_compute->totalTime() - compute_time_begin);
+  Real exchange_time = addMinMaxAvgRows(csv, pm, "Tracking exchange", m_timer_exchange->totalTime() - exchange_time_begin);
+  Real update_time = addMinMaxAvgRows(csv, pm, "Tracking update", m_timer_update->totalTime() - update_time_begin);
+  Real compaction_time = addMinMaxAvgRows(csv, pm, "Tracking compaction", m_timer_compaction->totalTime() - compaction_time_begin);
+  Integer nb_sub_iterations = pm->reduce(Parallel::ReduceMax, m_nb_sub_iterations);
+  csv->addElemRow("Tracking sub-iterations", nb_sub_iterations);
+
+  info() << "--- Tracking: compute " << compute_time
+         << " s / exchange " << exchange_time
+         << " s / family update " << update_time
+         << " s / compaction " << compaction_time
+         << " s (max) in " << nb_sub_iterations << " sub-iteration(s) ---";
+
+  // Figure of merit : nombre de segments suivis par seconde (m_num_segments
+  // n'est pas encore réduit, cf. QSModule::cycleFinalize()).
+  const Real local_time = m_timer->lastActivationTime();
+  const Real local_segments = static_cast<Real>(m_num_segments());
+  addMinMaxAvgRows(csv, pm, "Segments/s", (local_time > 0.0 ? local_segments / local_time : 0.0));
+
+  const Real total_segments = pm->reduce(Parallel::ReduceSum, local_segments);
+  const Real fom = (time > 0.0 ? total_segments / time : 0.0);
+  info() << "--- Figure of merit: " << fom << " segments/s ("
+         << fom / pm->commSize() << " segments/s/rank) ---";
+
+  csv->addElemRow("FOM", fom);
+  csv->addElemRow("FOM per rank", fom / pm->commSize());
+
+  // Charge des threads : temps du thread le plus chargé / temps moyen.
+  ConstArrayView<TrackingThreadLoad> loads = m_thread_loads.loads();
+  for (Integer i = 0; i < loads.size(); i++) {
+    if (loads[i].nb_batch > 0) {
+      pinfo(4) << "P" << pm->commRank() << " - Thread #" << i - 1
+               << " - particles: " << loads[i].nb_particle
+               << " / batches: " << loads[i].nb_batch
+               << " / busy time: " << loads[i].busy_time << " s";
+    }
+  }
+  Real thread_imbalance = addMinMaxAvgRows(csv, pm, "Tracking thread imbalance", m_thread_loads.imbalance());
+  info() << "--- Tracking thread imbalance (max/avg busy time): " << thread_imbalance << " ---";
+  m_thread_loads.reset();
+
+  addSubIterationRows(csv, pm);
+  m_nb_csv_cycles++;
+}
+
+/**
+ * @brief Méthode permettant d'ajouter dans le csv les temps de chaque
+ * sous-itération du tracking (lignes "Tracking sub-iteration #i compute max",
+ * "... update max" et "... exchange max", maximum sur les sous-domaines).
+ * Une sous-itération dont l'échange est long alors que le calcul est court
+ * indique une attente des autres sous-domaines.
+ * Une ligne créée pour une sous-itération reste remplie aux cycles suivants
+ * (0 si le cycle a moins de sous-itérations) et est complétée par des 0 pour
+ * les cycles précédents, pour garder les colonnes du csv alignées.
+ * En mode async, les sous-itérations (paquets) ne sont pas synchronisées
+ * entre les sous-domaines : aucune ligne n'est ajoutée.
+ * Doit être appelée par tous les sous-domaines.
+ *
+ * @param csv La sortie csv.
+ * @param pm Le gestionnaire du parallélisme.
+ */
+void TrackingMCModule::
+addSubIterationRows(ISimpleOutput* csv, IParallelMng* pm)
+{
+  Integer nb_sub_iterations = pm->reduce(Parallel::ReduceMax, m_sub_iteration_compute_times.size());
+  if (nb_sub_iterations == 0 && m_nb_sub_iteration_rows == 0) {
+    return;
+  }
+
+  // Une ligne par phase et par sous-itération.
+  const Integer nb_phase = 3;
+  RealUniqueArray times(nb_sub_iterations * nb_phase, 0.0);
+  for (Integer i = 0; i < m_sub_iteration_compute_times.size(); i++) {
+    times[i * nb_phase + 0] = m_sub_iteration_compute_times[i];
+    times[i * nb_phase + 1] = m_sub_iteration_update_times[i];
+    times[i * nb_phase + 2] = m_sub_iteration_exchange_times[i];
+  }
+  pm->reduce(Parallel::ReduceMax, times);
+
+  const char* phase_names[nb_phase] = { " compute max", " update max", " exchange max" };
+  const Integer nb_rows = std::max(nb_sub_iterations, m_nb_sub_iteration_rows);
+  for (Integer i = 0; i < nb_rows; i++) {
+    for (Integer p = 0; p < nb_phase; p++) {
+      String name = String("Tracking sub-iteration #") + String::fromNumber(i + 1) + phase_names[p];
+      if (i >= m_nb_sub_iteration_rows) {
+        for (Integer c = 0; c < m_nb_csv_cycles; c++) {
+          csv->addElemRow(name, 0.0);
+        }
+      }
+      csv->addElemRow(name, (i < nb_sub_iterations ? times[i * nb_phase + p] : 0.0));
+    }
+  }
+  m_nb_sub_iteration_rows = nb_rows;
+}
+
+/**
+ * @brief Méthode appelée après une modification du maillage (équilibrage de
+ * charge). Les structures indexées par le localId des mailles sont
+ * reconstruites.
+ */
+void TrackingMCModule::
+onMeshChanged()
+{
+  info() << "TrackingMC: OnMeshChanged";
+
+  const Integer nb_cell = mesh()->cellFamily()->maxLocalId();
+  m_flux_tally.init(nb_cell, m_n_groups(), options()->getFluxTallyMode());
+
+  if (m_use_segment_criterion) {
+    m_cell_work.init(nb_cell);
+  }
+  if (m_use_facet_geometry) {
+    initFacetGeometry();
+  }
 }
 
 /**
@@ -76,6 +237,10 @@ void TrackingMCModule::
 endModule()
 {
   delete (m_timer);
+  delete (m_timer_compute);
+  delete (m_timer_exchange);
+  delete (m_timer_update);
+  delete (m_timer_compaction);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -132,9 +297,18 @@ initNuclearData()
     m_material_mng->createEnvironment(ebi1);
   }
 
+  // Les matériaux doivent suivre la migration des mailles lors d'un équilibrage.
+  if (m_use_segment_criterion) {
+    m_material_mng->setMeshModificationNotified(true);
+  }
   m_material_mng->endCreate();
   m_nuclearData->_isotopes.reserve(num_isotopes);
 
+  // Les mailles sans matériau ont l'indice -1.
+  m_cell_material_index.fill(-1);
+  UniqueArray<Int32UniqueArray> material_isotopes(num_materials);
+  UniqueArray<RealUniqueArray> material_atom_fractions(num_materials);
+
   ConstArrayView<IMeshMaterial*> materials = m_material_mng->materials();
   {
     MeshMaterialModifier modifier(m_material_mng);
@@ -173,9 +347,8 @@ initNuclearData()
     {
       m_mass[icell] = mass;
       m_source_rate[icell] = sourceRate;
+      m_cell_material_index[(*icell).globalCell()] = i;
     }
-    m_iso_gid.resize(nIsotopes);
-    m_atom_fraction.resize(nIsotopes);
 
     for (Integer iIso = 0; iIso < nIsotopes; ++iIso) {
       Integer isotope_gid = m_nuclearData->addIsotope(
@@ -191,10 +364,52 @@ initNuclearData()
 
       // atom_fraction for each isotope is 1/nIsotopes.  Treats all
       // isotopes as equally prevalent.
-      ENUMERATE_MATCELL(icell, materials[i])
-      {
-        m_iso_gid[icell][iIso] = isotope_gid;
-        m_atom_fraction[icell][iIso] = 1.0 / nIsotopes;
+      material_isotopes[i].add(isotope_gid);
+      material_atom_fractions[i].add(1.0 / nIsotopes);
+    }
+  }
+
+  Timer timer_cross_section(subDomain(), "TrackingMCCrossSection", Timer::TimerReal);
+  {
+    Timer::Sentry ts(&timer_cross_section);
+    m_cross_section_table.build(m_nuclearData, m_n_groups(), material_isotopes, material_atom_fractions);
+  }
+  info() << "--- Cross section setup duration: " << timer_cross_section.lastActivationTime() << " s ---";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Méthode permettant de précalculer les facets de toutes les mailles.
+ * Les normales (m_normal_face) et les centres des faces (m_face_center_coord)
+ * doivent avoir été calculés (QSModule::initMesh()).
+ */
+void TrackingMCModule::
+initFacetGeometry()
+{
+  info() << "Précalcul des facets des mailles";
+
+  VariableNodeReal3& node_coord = nodesCoordinates();
+
+  m_facet_geometry.resize(mesh()->cellFamily()->maxLocalId());
+
+  ENUMERATE_CELL (icell, allCells()) {
+    Cell cell = *icell;
+
+    ENUMERATE_FACE (iface, cell.faces()) {
+      Face face = *iface;
+      const Real3 normal = m_normal_face[iface.index()];
+      const Real3 center = m_face_center_coord[iface];
+      const Real dd = -1.0 * (normal.x * center.x + normal.y * center.y + normal.z * center.z);
+      const Integer facet_index = iface.index() * 4;
+
+      for (Integer i = 0; i < 4; i++) {
+        Node first_node = face.node(i);
+        Node second_node = face.node((i == 3) ? 0 : i + 1);
+
+        m_facet_geometry.setFacet(icell.localId(), facet_index + i, normal, dd,
+                                  center, node_coord[first_node], node_coord[second_node]);
       }
     }
   }
@@ -222,29 +437,38 @@ tracking()
 
   pinfo(3) << "P" << mesh()->parallelMng()->commRank() << " - Tracking of " << processing_view.size() << " particles.";
 
+  initFluxTallyScale(processing_view);
+
   IParticleExchanger* pe = options()->particleExchanger();
-  //IAsyncParticleExchanger* ae = pe->asyncParticleExchanger();
   if (mesh()->parallelMng()->commSize() > 1) {
     pe->beginNewExchange(-123);
   }
 
   Integer particle_count = 0; // Initialize count of num_particles processed
   Integer iter = 1;
+  m_nb_sub_iterations = 0;
+  m_sub_iteration_compute_times.clear();
+  m_sub_iteration_update_times.clear();
+  m_sub_iteration_exchange_times.clear();
+
+  if (mesh()->parallelMng()->commSize() > 1 && options()->getExchangeMode() == eExchangeMode::ASYNC) {
+    IAsyncParticleExchanger* ae = pe->asyncParticleExchanger();
+    if (!ae) {
+      ARCANE_FATAL("Le mode async nécessite un particle-exchanger asynchrone (AsyncParticleExchanger).");
+    }
+    trackingAsync(ae, processing_view, node_coord);
+    done = true;
+  }
 
   while (!done) {
-    arcaneParallelForeach(processing_view, [&](ParticleVectorView particles) {
-      ENUMERATE_PARTICLE (iparticle, particles) {
-        Particle particle = (*iparticle);
-        cycleTrackingGuts(particle, node_coord);
-
-        //if (iparticle.index() % 50000 == 0) {
-        // pinfo(5) << "--------";
-        // pinfo(4) << "P" << mesh()->parallelMng()->commRank() << " - SubIter #" << iter << " - Number of particles processed : " << iparticle.index() << "/" << processing_view.size();
-        // pinfo(5) << "  m_local_ids_processed : " << m_census_a << " m_extra_particles_local_ids : " << m_extra_particles_local_ids.size();
-        // pinfo(5) << "--------";
-        //}
-      }
-    });
+    const Real compute_time_begin = m_timer_compute->totalTime();
+    const Real exchange_time_begin = m_timer_exchange->totalTime();
+    const Real update_time_begin = m_timer_update->totalTime();
+
+    {
+      Timer::Sentry ts(m_timer_compute);
+      trackParticles(processing_view, node_coord);
+    }
 
     particle_count += processing_view.size();
 
@@ -256,36 +480,38 @@ tracking()
 
       // pinfo(5) << "P" << mesh()->parallelMng()->commRank() << " - SubIter #" << iter << " - Computing incoming particles";
 
-      arcaneParallelForeach(incoming_particles_view, [&](ParticleVectorView particles) {
-        ENUMERATE_PARTICLE (iparticle, particles) {
-          Particle particle = (*iparticle);
-          cycleTrackingGuts(particle, node_coord);
-
-          // if (iparticle.index() % 50000 == 0) {
-          // pinfo(4) << "P" << mesh()->parallelMng()->commRank() << " - SubIter #" << iter << " - Number of incoming particles processed : " << iparticle.index() << "/" << incoming_particles_view.size();
-          // }
-        }
-      });
+      {
+        Timer::Sentry ts(m_timer_compute);
+        trackParticles(incoming_particles_view, node_coord);
+      }
       particle_count += incoming_particles_view.size();
 
       // pinfo(4) << "P" << mesh()->parallelMng()->commRank() << " - SubIter #" << iter << " - Number of incoming particles processed : " << incoming_particles_view.size() << "/" << incoming_particles_view.size();
     }
 
+    // Fusion des tallies de flux des threads.
+    m_flux_tally.merge();
+
     // pinfo(5) << "========";
     // pinfo(3) << "P" << mesh()->parallelMng()->commRank() << " - End SubIter #" << iter << " - Total number of particles processed : " << particle_count;
     // pinfo(5) << "  m_exited_particles_local_ids : " << m_exited_particles_local_ids.size() << " m_extra_particles_cellid_dst : " << m_extra_particles_cellid_dst.size() << " m_extra_particles_local_ids : " << m_extra_particles_local_ids.size();
     // pinfo(5) << "  m_local_ids_processed : " << m_census_a << " m_exited_particles_local_ids : " << m_exited_particles_local_ids.size();
     // pinfo(5) << "========";
 
-    // On retire les particules qui sont sortie du maillage.
-    m_particle_family->toParticleFamily()->removeParticles(m_exited_particles_local_ids);
-    // endUpdate fait par collisionEventSuite;
-    m_exited_particles_local_ids.clear();
+    {
+      Timer::Sentry ts(m_timer_update);
 
-    // On effectue la suite des collisions, si besoin.
-    collisionEventSuite();
+      // On retire les particules qui sont sortie du maillage.
+      m_particle_family->toParticleFamily()->removeParticles(m_exited_particles_local_ids);
+      // endUpdate fait par collisionEventSuite;
+      m_exited_particles_local_ids.clear();
+
+      // On effectue la suite des collisions, si besoin.
+      collisionEventSuite();
+    }
 
     if (mesh()->parallelMng()->commSize() > 1) {
+      Timer::Sentry ts(m_timer_exchange);
       incoming_particles_local_ids.clear();
 
       // On essaye de recevoir tant que quelqu'un bosse encore.
@@ -318,35 +544,221 @@ tracking()
     m_extra_particles_local_ids.clear();
 
     processing_view = m_particle_family->view(extra_clone);
+
+    m_sub_iteration_compute_times.add(m_timer_compute->totalTime() - compute_time_begin);
+    m_sub_iteration_update_times.add(m_timer_update->totalTime() - update_time_begin);
+    m_sub_iteration_exchange_times.add(m_timer_exchange->totalTime() - exchange_time_begin);
+
+    pinfo(4) << "P" << mesh()->parallelMng()->commRank() << " - SubIter #" << iter
+             << " - compute: " << m_sub_iteration_compute_times.back()
+             << " s / family update: " << m_sub_iteration_update_times.back()
+             << " s / exchange: " << m_sub_iteration_exchange_times.back() << " s";
+
+    m_nb_sub_iterations = iter;
     iter++;
   }
 
+  m_flux_tally.flush(m_scalar_flux_tally, allCells());
+
   m_end = m_particle_family->view().size();
 }
 
 /**
- * @brief Méthode permettant de copier les atomics dans les variables Arcane.
+ * @brief Méthode permettant de suivre les particules avec un échange asynchrone.
+ * Les particules à suivre sont traitées par paquets de exchange_chunk_size.
+ * Après chaque paquet, les particules sortantes sont envoyées et les
+ * particules reçues sont ajoutées aux particules à suivre, sans attendre
+ * les autres sous-domaines.
+ * La fin globale est détectée par l'échangeur (sans réduction bloquante) :
+ * exchangeItemsAsync() retourne vrai lorsqu'aucun sous-domaine n'a plus
+ * de particules à suivre ni de messages en vol.
+ *
+ * @param ae L'échangeur asynchrone.
+ * @param particles Les particules à suivre.
+ * @param node_coord Les coordonnées des nodes.
+ */
+void TrackingMCModule::
+trackingAsync(IAsyncParticleExchanger* ae, ParticleVectorView particles, VariableNodeReal3& node_coord)
+{
+  const Integer chunk_size = options()->getExchange_chunk_size();
+
+  // Les localIds des particules restant à suivre.
+  Int32UniqueArray pending_local_ids(particles.localIds());
+  Int32UniqueArray chunk_local_ids;
+  Int32UniqueArray incoming_particles_local_ids;
+
+  bool done = false;
+  while (!done) {
+    // On prend un paquet à la fin de la liste.
+    Integer nb_chunk = std::min(chunk_size, pending_local_ids.size());
+    Integer nb_remaining = pending_local_ids.size() - nb_chunk;
+    chunk_local_ids.copy(pending_local_ids.subConstView(nb_remaining, nb_chunk));
+    pending_local_ids.resize(nb_remaining);
+
+    if (nb_chunk > 0) {
+      Timer::Sentry ts(m_timer_compute);
+      // La vue est recréée à chaque paquet car l'ajout de particules peut
+      // invalider les vues existantes.
+      trackParticles(m_particle_family->view(chunk_local_ids), node_coord);
+    }
+
+    // Quand on ne fait qu'attendre des particules, il n'y a rien à mettre
+    // à jour dans la famille (pas d'endUpdate() inutile).
+    if (nb_chunk > 0 || !m_exited_particles_local_ids.empty() || !m_collision_staging.empty()) {
+      Timer::Sentry ts(m_timer_update);
+
+      // On retire les particules qui sont sortie du maillage.
+      m_particle_family->toParticleFamily()->removeParticles(m_exited_particles_local_ids);
+      // endUpdate fait par collisionEventSuite;
+      m_exited_particles_local_ids.clear();
+
+      // On effectue la suite des collisions, si besoin.
+      collisionEventSuite();
+    }
+    pending_local_ids.addRange(m_extra_particles_local_ids);
+    m_extra_particles_local_ids.clear();
+
+    // Envoi des particules sortantes et réception des particules arrivées.
+    incoming_particles_local_ids.clear();
+    {
+      Timer::Sentry ts(m_timer_exchange);
+      done = ae->exchangeItemsAsync(m_outgoing_particles_local_ids.size(), m_outgoing_particles_local_ids,
+                                    m_outgoing_particles_rank_to, &incoming_particles_local_ids, nullptr,
+                                    !pending_local_ids.empty());
+    }
+    // En mode asynchrone, une sous-itération correspond à un paquet suivi.
+    if (nb_chunk > 0) {
+      m_nb_sub_iterations++;
+    }
+
+    m_outgoing_particles_rank_to.clear();
+    m_outgoing_particles_local_ids.clear();
+
+    pending_local_ids.addRange(incoming_particles_local_ids);
+  }
+}
+
+/**
+ * @brief Méthode permettant de suivre un ensemble de particules avec le
+ * moteur de tracking choisi dans le jeu de données.
+ *
+ * @param particles Les particules à suivre.
+ * @param node_coord Les coordonnées des nodes.
+ */
+void TrackingMCModule::
+trackParticles(ParticleVectorView particles, VariableNodeReal3& node_coord)
+{
+  if (options()->getTrackingEngine() == eTrackingEngine::EVENT) {
+    trackingEventBased(particles, node_coord);
+    return;
+  }
+
+  Int32UniqueArray sorted_local_ids;
+  if (options()->getTrackingCostSort()) {
+    sortParticlesByCost(particles, sorted_local_ids);
+    particles = m_particle_family->view(sorted_local_ids);
+  }
+
+  // Les lots de grain_size particules sont répartis dynamiquement entre
+  // les threads par le gestionnaire de tâches.
+  arcaneParallelForeach(particles, m_tracking_loop_options, [&](ParticleVectorView sub_particles) {
+    const Real begin_time = platform::getRealTime();
+
+    ENUMERATE_PARTICLE (iparticle, sub_particles) {
+      Particle particle = (*iparticle);
+      cycleTrackingGuts(particle, node_coord);
+    }
+
+    m_thread_loads.local().addBatch(sub_particles.size(), begin_time);
+  });
+}
+
+/**
+ * @brief Méthode permettant de trier les particules par coût estimé décroissant.
+ * Le coût d'une particule est estimé par le nombre moyen de collisions avant
+ * son census (section efficace totale de sa maille * distance jusqu'au
+ * census), plus un pour le segment final. Les particules les plus coûteuses
+ * sont distribuées en premier, ce qui réduit l'attente des threads en fin de
+ * sous-itération.
+ *
+ * @param particles Les particules à trier.
+ * @param sorted_local_ids Les localIds des particules triées.
+ */
+void TrackingMCModule::
+sortParticlesByCost(ParticleVectorView particles, Int32Array& sorted_local_ids)
+{
+  const Integer nb_particle = particles.size();
+  Int32ConstArrayView local_ids = particles.localIds();
+  RealUniqueArray costs(nb_particle);
+
+  arcaneParallelFor(0, nb_particle, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); i++) {
+      Particle particle = particles[i];
+      Real time_census = m_particle_time_census[particle];
+      if (time_census <= 0.0) {
+        time_census += m_global_deltat();
+      }
+      const Real path_length = m_particle_velocity[particle].normL2() * time_census;
+      costs[i] = 1.0 + path_length * weightedMacroscopicCrossSection(particle.cell(), m_particle_ene_grp[particle]);
+    }
+  });
+
+  Int32UniqueArray order(nb_particle);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](Int32 a, Int32 b) { return costs[a] > costs[b]; });
+
+  sorted_local_ids.resize(nb_particle);
+  for (Integer i = 0; i < nb_particle; i++) {
+    sorted_local_ids[i] = local_ids[order[i]];
+  }
+}
+
+/**
+ * @brief Méthode permettant de calculer le facteur d'échelle du tally de flux.
+ * Une particule parcourt au plus c * dt pendant une itération, la somme des
+ * contributions est donc bornée par N * poids_max * c * dt. On prend une
+ * marge pour les particules créées par les fissions.
+ * La borne est calculée avec des réductions globales pour qu'elle ne dépende
+ * ni du nombre de threads ni de la répartition des particules.
+ *
+ * @param particles Les particules à suivre.
+ */
+void TrackingMCModule::
+initFluxTallyScale(ParticleVectorView particles)
+{
+  const Real margin = 16.0;
+
+  Real max_weight = 0.0;
+  ENUMERATE_PARTICLE (iparticle, particles) {
+    max_weight = std::max(max_weight, m_particle_weight[iparticle]);
+  }
+
+  IParallelMng* pm = mesh()->parallelMng();
+  max_weight = pm->reduce(Parallel::ReduceMax, max_weight);
+  Int64 nb_particle = pm->reduce(Parallel::ReduceSum, (Int64)particles.size());
+
+  Real flux_bound = margin * nb_particle * max_weight * PhysicalConstants::_speedOfLight * m_global_deltat();
+  m_flux_tally.computeScale(flux_bound);
+}
+
+/**
+ * @brief Méthode permettant de copier les compteurs des threads dans les variables Arcane.
  */
 void TrackingMCModule::
 updateTallies()
 {
-  m_absorb = m_absorb_a;
-  m_census = m_census_a;
-  m_escape = m_escape_a;
-  m_collision = m_collision_a;
-  m_fission = m_fission_a;
-  m_produce = m_produce_a;
-  m_scatter = m_scatter_a;
-  m_num_segments = m_num_segments_a;
-
-  m_absorb_a = 0;
-  m_census_a = 0;
-  m_escape_a = 0;
-  m_collision_a = 0;
-  m_fission_a = 0;
-  m_produce_a = 0;
-  m_scatter_a = 0;
-  m_num_segments_a = 0;
+  TrackingEventCounters counters = m_counters.sum();
+
+  m_absorb = counters.absorb;
+  m_census = counters.census;
+  m_escape = counters.escape;
+  m_collision = counters.collision;
+  m_fission = counters.fission;
+  m_produce = counters.produce;
+  m_scatter = counters.scatter;
+  m_num_segments = counters.num_segments;
+
+  m_counters.reset();
 }
 
 /**
@@ -447,7 +859,10 @@ cycleTrackingFunction(Particle particle, VariableNodeReal3& node_coord)
     //   (2) Reach the end of the time step and enter census,
     //
     computeNextEvent(particle, node_coord);
-    m_num_segments_a++;
+    m_counters.local().num_segments++;
+    if (m_use_segment_criterion) {
+      m_cell_work.add(particle.cell().localId());
+    }
 
     m_particle_num_seg[particle] += 1.; /* Track the number of segments this particle has
                                           undergone this cycle on all processes. */
@@ -459,7 +874,7 @@ cycleTrackingFunction(Particle particle, VariableNodeReal3& node_coord)
         done = false;
         m_particle_status[particle] = ParticleState::exitedParticle;
         {
-          GlobalMutex::ScopedLock(m_mutex_exit);
+          GlobalMutex::ScopedLock sl(m_mutex_exit);
           m_exited_particles_local_ids.add(particle.localId());
         }
         break;
@@ -485,11 +900,11 @@ cycleTrackingFunction(Particle particle, VariableNodeReal3& node_coord)
         break;
 
       case ParticleEvent::escape:
-        m_escape_a++;
+        m_counters.local().escape++;
         done = false;
         m_particle_status[particle] = ParticleState::exitedParticle;
         {
-          GlobalMutex::ScopedLock(m_mutex_exit);
+          GlobalMutex::ScopedLock sl(m_mutex_exit);
           m_exited_particles_local_ids.add(particle.localId());
         }
         break;
@@ -513,7 +928,7 @@ cycleTrackingFunction(Particle particle, VariableNodeReal3& node_coord)
       //   GlobalMutex::ScopedLock(m_mutex_processed);
       //   m_local_ids_processed.add(particle.localId());
       // }
-      m_census_a++;
+      m_counters.local().census++;
       done = false;
       m_particle_status[particle] = ParticleState::censusParticle;
       break;
@@ -536,61 +951,58 @@ cycleTrackingFunction(Particle particle, VariableNodeReal3& node_coord)
 void TrackingMCModule::
 collisionEventSuite()
 {
+  ArrayView<CollisionStaging> stagings = m_collision_staging.stagings();
+
   // On créé les particules.
-  Int32UniqueArray particles_lid(m_extra_particles_global_id.size());
+  // Les produits de chaque thread sont placés les uns à la suite des autres.
+  Integer nb_secondaries = m_collision_staging.nbSecondaries();
+  Int64UniqueArray particles_uid(nb_secondaries);
+  Int32UniqueArray cells_lid(nb_secondaries);
+  Int32UniqueArray particles_lid(nb_secondaries);
+
+  Integer index = 0;
+  for (const CollisionStaging& staging : stagings) {
+    for (const SecondaryParticle& secondary : staging.secondaries) {
+      particles_uid[index] = secondary.rns & ~(1UL << 63);
+      cells_lid[index] = secondary.cell_lid;
+      index++;
+    }
+  }
 
-  m_particle_family->toParticleFamily()->addParticles(m_extra_particles_global_id, m_extra_particles_cellid_dst, particles_lid);
+  m_particle_family->toParticleFamily()->addParticles(particles_uid, cells_lid, particles_lid);
   m_particle_family->toParticleFamily()->endUpdate();
 
-  // On leur donne les bonnes propriétés.
-  cloneParticles(m_extra_particles_particle_src, particles_lid, m_extra_particles_rns);
+  // On leur donne les bonnes propriétés, un lot contigu par thread.
+  Integer offset = 0;
+  for (const CollisionStaging& staging : stagings) {
+    Integer nb_staged = staging.secondaries.size();
+    cloneParticles(staging.secondaries, particles_lid.subConstView(offset, nb_staged));
+    offset += nb_staged;
+  }
 
-  ParticleVectorView particles_view = m_particle_family->view(particles_lid);
+  // On effectue la suite de la collision des particules sources.
+  ItemInternalList particles_internal = m_particle_family->itemsInternal();
 
-  // On effectue la suite de la collision.
-  arcaneParallelFor(0, particles_view.size(), [&](Integer begin, Integer size) {
-    for (Integer i = begin; i < (begin + size); i++) {
-      Particle particle(particles_view[i].internal());
-      updateTrajectory(m_extra_particles_energy_out[i], m_extra_particles_angle_out[i], particle);
-    }
-  });
-  // ENUMERATE_PARTICLE(ipartic, particles_view) {
-  //   Integer index = ipartic.index();
-  //   updateTrajectory(m_extra_particles_energy_out[index], m_extra_particles_angle_out[index], (*ipartic));
-  // }
+  for (const CollisionStaging& staging : stagings) {
+    ConstArrayView<SplitParticle> sources = staging.sources;
 
-  particles_view = m_particle_family->view(m_extra_particles_local_ids);
+    arcaneParallelFor(0, sources.size(), [&](Integer begin, Integer size) {
+      for (Integer i = begin; i < (begin + size); i++) {
+        Particle particle(particles_internal[sources[i].local_id]);
+        updateTrajectory(sources[i].energy, sources[i].angle, particle);
+        m_particle_ene_grp[particle] = m_nuclearData->getEnergyGroup(m_particle_kin_ene[particle]);
+      }
+    });
 
-  arcaneParallelFor(0, particles_view.size(), [&](Integer begin, Integer size) {
-    for (Integer i = begin; i < (begin + size); i++) {
-      Particle particle(particles_view[i].internal());
-      updateTrajectory(m_extra_particles_energy_out_particle_src[i], m_extra_particles_angle_out_particle_src[i], particle);
-      m_particle_ene_grp[particle] = m_nuclearData->getEnergyGroup(m_particle_kin_ene[particle]);
+    for (const SplitParticle& source : sources) {
+      m_extra_particles_local_ids.add(source.local_id);
     }
-  });
-
-  // ENUMERATE_PARTICLE(ipartic, particles_view) {
-  //   Integer index = ipartic.index();
-  //   updateTrajectory(m_extra_particles_energy_out_particle_src[index], m_extra_particles_angle_out_particle_src[index], (*ipartic));
-  //   m_particle_ene_grp[ipartic] = m_nuclearData->getEnergyGroup(m_particle_kin_ene[ipartic]);
-  // }
-
-  //m_extra_particles_local_ids.copy(particles_lid);
+  }
 
-  //m_extra_particles_local_ids.resize(m_extra_particles_local_ids.size() + particles_lid.size());
   // On fusionne la liste des particules sources et la liste des nouvelles particules.
-  for (Integer i = 0; i < particles_lid.size(); i++) {
-    m_extra_particles_local_ids.add(particles_lid[i]);
-  }
+  m_extra_particles_local_ids.addRange(particles_lid);
 
-  m_extra_particles_rns.clear();
-  m_extra_particles_global_id.clear();
-  m_extra_particles_cellid_dst.clear();
-  m_extra_particles_particle_src.clear();
-  m_extra_particles_energy_out.clear();
-  m_extra_particles_angle_out.clear();
-  m_extra_particles_energy_out_particle_src.clear();
-  m_extra_particles_angle_out_particle_src.clear();
+  m_collision_staging.clear();
 }
 
 /**
@@ -628,8 +1040,7 @@ computeNextEvent(Particle particle, VariableNodeReal3& node_coord)
 
   // Randomly determine the distance to the next collision
   // based upon the composition of the current cell.
-  //Real macroscopic_total_cross_section = weightedMacroscopicCrossSection(particle.cell(), m_particle_ene_grp[particle]);
-  Real macroscopic_total_cross_section = m_total[particle.cell()][m_particle_ene_grp[particle]];
+  Real macroscopic_total_cross_section = weightedMacroscopicCrossSection(particle.cell(), m_particle_ene_grp[particle]);
 
   // Cache the cross section
   m_particle_total_cross_section[particle] = macroscopic_total_cross_section;
@@ -733,9 +1144,7 @@ computeNextEvent(Particle particle, VariableNodeReal3& node_coord)
   }
 
   // Accumulate the particle's contribution to the scalar flux.
-  // Atomic
-  GlobalMutex::ScopedLock(m_mutex_flux);
-  m_scalar_flux_tally[particle.cell()][m_particle_ene_grp[particle]] += m_particle_seg_path_length[particle] * m_particle_weight[particle];
+  m_flux_tally.add(particle.cell().localId(), m_particle_ene_grp[particle], m_particle_seg_path_length[particle] * m_particle_weight[particle]);
 }
 
 /**
@@ -752,67 +1161,40 @@ collisionEvent(Particle particle)
   Cell cell = particle.cell();
 
   // Pick the isotope and reaction.
-  Real random_number = rngSample(&m_particle_rns[particle]);
-  Real total_cross_section = m_particle_total_cross_section[particle];
-  Real current_cross_section = total_cross_section * random_number;
-
-  Integer selected_iso = -1;
-  Integer selected_unique_number = -1;
-  Integer selected_react = -1;
-
-  Real cell_number_density = m_cell_number_density[cell];
-  ConstArrayView<Real> atom_fraction_av = m_atom_fraction[cell];
-  ConstArrayView<Integer> isotope_gid_av = m_iso_gid[cell];
-
-  Integer num_isos = isotope_gid_av.size();
-
-  for (Integer isoIndex = 0; isoIndex < num_isos && current_cross_section >= 0; isoIndex++) {
-    const Real atom_fraction = atom_fraction_av[isoIndex];
-    const Integer isotope_gid = isotope_gid_av[isoIndex];
-    Integer numReacts = m_nuclearData->getNumberReactions(isotope_gid);
-    for (Integer reactIndex = 0; reactIndex < numReacts; reactIndex++) {
-      current_cross_section -= macroscopicCrossSection(reactIndex, cell_number_density, atom_fraction, isotope_gid,
-                                                       isoIndex, m_particle_ene_grp[particle]);
-      if (current_cross_section < 0) {
-        selected_iso = isoIndex;
-        selected_unique_number = isotope_gid;
-        selected_react = reactIndex;
-        break;
-      }
-    }
-  }
-  ARCANE_ASSERT(selected_iso != -1, "selected_iso == -1");
+  NuclearDataReaction& reaction = sampleReaction(cell, m_particle_ene_grp[particle], &m_particle_rns[particle]);
 
   Integer max_production_size = options()->getMax_production_size();
 
   // Do the collision.
-  RealUniqueArray energyOut(max_production_size);
-  RealUniqueArray angleOut(max_production_size);
+  CollisionStaging& staging = m_collision_staging.local();
+  ArrayView<Real> energyOut = staging.energy_out;
+  ArrayView<Real> angleOut = staging.angle_out;
   Integer nOut = 0;
   Real mat_mass = m_mass[cell];
 
-  m_nuclearData->_isotopes[selected_unique_number]._species[0]._reactions[selected_react].sampleCollision(
-  m_particle_kin_ene[particle], mat_mass, energyOut, angleOut, nOut, &(m_particle_rns[particle]), max_production_size);
+  reaction.sampleCollision(m_particle_kin_ene[particle], mat_mass, energyOut, angleOut, nOut,
+                           &(m_particle_rns[particle]), max_production_size);
 
-  m_collision_a++;
+  TrackingEventCounters& counters = m_counters.local();
+  counters.collision++;
 
 // Dans QS original, une particule peut se fissionner en 1 partie (une particule => une particule).
 // {nOut = 1 / reactionType = Fission} possible.
 #ifdef QS_LEGACY_COMPATIBILITY
 
   // Set the reaction for this particle.
-  NuclearDataReaction::Enum reactionType = m_nuclearData->_isotopes[selected_unique_number]._species[0]._reactions[selected_react]._reactionType;
+  NuclearDataReaction::Enum reactionType = reaction._reactionType;
 
   switch (reactionType) {
   case NuclearDataReaction::Absorption:
-    m_absorb_a++;
+    counters.absorb++;
     break;
   case NuclearDataReaction::Scatter:
-    m_scatter_a++;
+    counters.scatter++;
     break;
   case NuclearDataReaction::Fission:
-    m_fission_a++;
-    m_produce_a += nOut;
+    counters.fission++;
+    counters.produce += nOut;
     break;
   case NuclearDataReaction::Undefined:
     ARCANE_ASSERT(false, "reactionType invalid");
@@ -823,7 +1205,7 @@ collisionEvent(Particle particle)
   // Si nOut == 0, la particule est absorbée.
   if (nOut == 0) {
 #ifndef QS_LEGACY_COMPATIBILITY
-    m_absorb_a++;
+    counters.absorb++;
 #endif
 
     return 0;
@@ -832,7 +1214,7 @@ collisionEvent(Particle particle)
   // Si nOut == 1, la particule change de trajectoire.
   else if (nOut == 1) {
 #ifndef QS_LEGACY_COMPATIBILITY
-    m_scatter_a++;
+    counters.scatter++;
 #endif
     updateTrajectory(energyOut[0], angleOut[0], particle);
     m_particle_ene_grp[particle] = m_nuclearData->getEnergyGroup(m_particle_kin_ene[particle]);
@@ -849,30 +1231,62 @@ collisionEvent(Particle particle)
   // On enregistre les infos pour la future phase création des particules.
   else {
 #ifndef QS_LEGACY_COMPATIBILITY
-    m_fission_a++;
-    m_produce_a += nOut;
+    counters.fission++;
+    counters.produce += nOut;
 #endif
 
-    GlobalMutex::ScopedLock(m_mutex_extra);
+    // Pas de verrou : chaque thread a sa zone de stockage.
     for (Integer i = 1; i < nOut; i++) {
       Int64 rns = rngSpawn_Random_Number_Seed(&m_particle_rns[particle]);
-      m_extra_particles_rns.add(rns);
-      rns &= ~(1UL << 63);
-      m_extra_particles_global_id.add(rns);
-      m_extra_particles_cellid_dst.add(particle.cell().localId());
-      m_extra_particles_particle_src.add(particle.localId());
-      m_extra_particles_energy_out.add(energyOut[i]);
-      m_extra_particles_angle_out.add(angleOut[i]);
+      staging.secondaries.add(SecondaryParticle{ rns, particle.cell().localId(), particle.localId(), energyOut[i], angleOut[i] });
     }
 
-    m_extra_particles_local_ids.add(particle.localId());
-    m_extra_particles_energy_out_particle_src.add(energyOut[0]);
-    m_extra_particles_angle_out_particle_src.add(angleOut[0]);
+    staging.sources.add(SplitParticle{ particle.localId(), energyOut[0], angleOut[0] });
   }
 
   return nOut;
 }
 
+/**
+ * @brief Méthode permettant de choisir l'isotope et la réaction d'une collision.
+ * Le choix se fait dans la fonction de répartition du matériau de la
+ * cellule (cf. CrossSectionTable), la densité de la cellule étant un
+ * simple facteur commun à toutes les réactions.
+ *
+ * @param cell La cellule où a lieu la collision.
+ * @param energy_group Le groupe d'énergie de la particule.
+ * @param rns La graine de la particule.
+ * @return NuclearDataReaction& La réaction choisie.
+ */
+NuclearDataReaction& TrackingMCModule::
+sampleReaction(Cell cell, const Integer& energy_group, Int64* rns)
+{
+  return sampleReaction(m_cell_material_index[cell], energy_group, rns);
+}
+
+/**
+ * @brief Méthode permettant de choisir l'isotope et la réaction d'une collision
+ * à partir de l'indice de matériau de la cellule.
+ *
+ * @param material L'indice du matériau de la cellule.
+ * @param energy_group Le groupe d'énergie de la particule.
+ * @param rns La graine de la particule.
+ * @return NuclearDataReaction& La réaction choisie.
+ */
+NuclearDataReaction& TrackingMCModule::
+sampleReaction(Integer material, const Integer& energy_group, Int64* rns)
+{
+  Real random_number = rngSample(rns);
+
+  ARCANE_ASSERT(material != -1, "Collision dans une maille sans matériau");
+
+  const Integer entry = m_cross_section_table.sample(material, energy_group, random_number);
+  const Integer isotope_gid = m_cross_section_table.entryIsotope(material, entry);
+  const Integer reaction = m_cross_section_table.entryReaction(material, entry);
+
+  return m_nuclearData->_isotopes[isotope_gid]._species[0]._reactions[reaction];
+}
+
 /**
  * @brief Méthode permettant d'exécuter l'événement faceEventUndefined.
  * Et de définir le 'Undefined' :
@@ -886,7 +1300,7 @@ collisionEvent(Particle particle)
 void TrackingMCModule::
 facetCrossingEvent(Particle particle)
 {
-  GlobalMutex::ScopedLock(m_mutex_out);
+  GlobalMutex::ScopedLock sl(m_mutex_out);
   Face face = particle.cell().face(m_particle_face[particle]);
   m_particle_last_event[particle] = m_boundary_cond[face];
 
@@ -919,50 +1333,59 @@ facetCrossingEvent(Particle particle)
 void TrackingMCModule::
 reflectParticle(Particle particle, VariableNodeReal3& node_coord)
 {
-  Real3 facet_normal(m_normal_face[m_particle_face[particle]]);
+  reflectParticle(m_particle_face[particle], m_particle_dir_cos[particle], m_particle_velocity[particle]);
+}
 
-  Real dot = 2.0 * (m_particle_dir_cos[particle][MD_DirA] * facet_normal.x + m_particle_dir_cos[particle][MD_DirB] * facet_normal.y + m_particle_dir_cos[particle][MD_DirG] * facet_normal.z);
+/**
+ * @brief Méthode permettant d'exécuter l'événement reflection.
+ *
+ * @param face_index La position de la face dans la cellule.
+ * @param dir_cos Les cosinus directeurs de la particule.
+ * @param velocity La vitesse de la particule.
+ */
+void TrackingMCModule::
+reflectParticle(const Integer& face_index, Real3& dir_cos, Real3& velocity)
+{
+  Real3 facet_normal(m_normal_face[face_index]);
+
+  Real dot = 2.0 * (dir_cos[MD_DirA] * facet_normal.x + dir_cos[MD_DirB] * facet_normal.y + dir_cos[MD_DirG] * facet_normal.z);
 
   // do not reflect a particle that is ALREADY pointing inward
   if (dot > 0) {
     // reflect the particle
-    m_particle_dir_cos[particle][MD_DirA] -= dot * facet_normal.x;
-    m_particle_dir_cos[particle][MD_DirB] -= dot * facet_normal.y;
-    m_particle_dir_cos[particle][MD_DirG] -= dot * facet_normal.z;
+    dir_cos[MD_DirA] -= dot * facet_normal.x;
+    dir_cos[MD_DirB] -= dot * facet_normal.y;
+    dir_cos[MD_DirG] -= dot * facet_normal.z;
   }
 
   // Calculate the reflected, velocity components.
-  Real particle_speed = m_particle_velocity[particle].normL2();
-  m_particle_velocity[particle][MD_DirX] = particle_speed * m_particle_dir_cos[particle][MD_DirA];
-  m_particle_velocity[particle][MD_DirY] = particle_speed * m_particle_dir_cos[particle][MD_DirB];
-  m_particle_velocity[particle][MD_DirZ] = particle_speed * m_particle_dir_cos[particle][MD_DirG];
+  Real particle_speed = velocity.normL2();
+  velocity[MD_DirX] = particle_speed * dir_cos[MD_DirA];
+  velocity[MD_DirY] = particle_speed * dir_cos[MD_DirB];
+  velocity[MD_DirZ] = particle_speed * dir_cos[MD_DirG];
 }
 
 /**
  * @brief Méthode permettant de cloner des particules.
- * Copie des propriétés de particules sources vers les particules destinations.
- * La taille des trois tableaux doit être identique.
+ * Copie des propriétés de particules sources vers les particules destinations
+ * puis mise à jour de la trajectoire des particules destinations.
+ * La taille des deux tableaux doit être identique.
  * 
- * @param idsSrc Tableau des ids des particules sources.
- * @param idsNew Tableau des ids des particules destinations.
- * @param rnsNew Tableau contenant les graines à donner aux particules.
+ * @param secondaries Les produits de collision d'un thread.
+ * @param new_local_ids Tableau des ids des particules destinations.
  */
 void TrackingMCModule::
-cloneParticles(Int32UniqueArray idsSrc, Int32UniqueArray idsNew, Int64UniqueArray rnsNew)
+cloneParticles(ConstArrayView<SecondaryParticle> secondaries, ConstArrayView<Int32> new_local_ids)
 {
-  ParticleVectorView src_particles_view = m_particle_family->view(idsSrc);
-  ParticleVectorView cloned_particles_view = m_particle_family->view(idsNew);
-
-  // ENUMERATE_PARTICLE (ipartic, src_particles_view) {
-  //   Particle pNew(cloned_particles_view[ipartic.index()].internal());
-  //   cloneParticle((*ipartic), pNew, rnsNew[ipartic.index()]);
-  // }
+  ItemInternalList particles_internal = m_particle_family->itemsInternal();
 
-  arcaneParallelFor(0, idsSrc.size(), [&](Integer begin, Integer size) {
+  arcaneParallelFor(0, secondaries.size(), [&](Integer begin, Integer size) {
     for (Integer i = begin; i < (begin + size); i++) {
-      Particle p_src(src_particles_view[i].internal());
-      Particle p_new(cloned_particles_view[i].internal());
-      cloneParticle(p_src, p_new, rnsNew[i]);
+      const SecondaryParticle& secondary = secondaries[i];
+      Particle p_src(particles_internal[secondary.src_lid]);
+      Particle p_new(particles_internal[new_local_ids[i]]);
+      cloneParticle(p_src, p_new, secondary.rns);
+      updateTrajectory(secondary.energy, secondary.angle, p_new);
     }
   });
 }
@@ -1019,142 +1442,178 @@ cloneParticle(Particle pSrc, Particle pNew, const Int64& rns)
 void TrackingMCModule::
 updateTrajectory(const Real& energy, const Real& angle, Particle particle)
 {
-  m_particle_kin_ene[particle] = energy;
+  updateTrajectory(energy, angle, m_particle_kin_ene[particle], m_particle_dir_cos[particle],
+                   m_particle_velocity[particle], m_particle_num_mean_free_path[particle],
+                   &m_particle_rns[particle]);
+}
+
+/**
+ * @brief Méthode permettant de mettre à jour la trajectoire d'une particule
+ * à partir de ses grandeurs.
+ *
+ * @param energy Energie cinétique de la particule.
+ * @param angle Angle permettant de mettre à jour la trajectoire de la particule.
+ * @param kin_ene L'énergie cinétique de la particule (en sortie).
+ * @param dir_cos Les cosinus directeurs de la particule.
+ * @param velocity La vitesse de la particule (en sortie).
+ * @param num_mean_free_path Le nombre de libres parcours moyens (en sortie).
+ * @param rns La graine de la particule.
+ */
+void TrackingMCModule::
+updateTrajectory(const Real& energy, const Real& angle, Real& kin_ene,
+                 Real3& dir_cos, Real3& velocity, Real& num_mean_free_path, Int64* rns)
+{
+  kin_ene = energy;
   Real cosTheta = angle;
-  Real random_number = rngSample(&m_particle_rns[particle]);
+  Real random_number = rngSample(rns);
   Real phi = 2 * 3.14159265 * random_number;
   Real sinPhi = sin(phi);
   Real cosPhi = cos(phi);
   Real sinTheta = sqrt((1.0 - (cosTheta * cosTheta)));
 
-  rotate3DVector(particle, sinTheta, cosTheta, sinPhi, cosPhi);
+  rotate3DVector(dir_cos, sinTheta, cosTheta, sinPhi, cosPhi);
 
   Real speed = (PhysicalConstants::_speedOfLight *
                 sqrt((1.0 - ((PhysicalConstants::_neutronRestMassEnergy * PhysicalConstants::_neutronRestMassEnergy) / ((energy + PhysicalConstants::_neutronRestMassEnergy) * (energy + PhysicalConstants::_neutronRestMassEnergy))))));
 
-  m_particle_velocity[particle][MD_DirX] = speed * m_particle_dir_cos[particle][MD_DirA];
-  m_particle_velocity[particle][MD_DirY] = speed * m_particle_dir_cos[particle][MD_DirB];
-  m_particle_velocity[particle][MD_DirZ] = speed * m_particle_dir_cos[particle][MD_DirG];
+  velocity[MD_DirX] = speed * dir_cos[MD_DirA];
+  velocity[MD_DirY] = speed * dir_cos[MD_DirB];
+  velocity[MD_DirZ] = speed * dir_cos[MD_DirG];
 
-  random_number = rngSample(&m_particle_rns[particle]);
-  m_particle_num_mean_free_path[particle] = -1.0 * std::log(random_number);
+  random_number = rngSample(rns);
+  num_mean_free_path = -1.0 * std::log(random_number);
 }
 
 /**
- * @brief Méthode permettant de déterminer les cross sections de toutes les mailles.
+ * @brief Méthode permettant de calculer la section efficace macroscopique totale
+ * d'une maille.
+ * La section efficace de chaque matériau est précalculée dans m_cross_section_table,
+ * seule la densité de la maille est appliquée ici.
+ * 
+ * @param cell La cellule où se trouve la particule
+ * @param energyGroup Le groupe d'energie.
+ * @return Real La section efficace macroscopique totale.
  */
-void TrackingMCModule::
-computeCrossSection()
+Real TrackingMCModule::
+weightedMacroscopicCrossSection(Cell cell, const Integer& energyGroup)
 {
-  arcaneParallelForeach(ownCells(), [&](CellVectorView cells) {
-    ENUMERATE_CELL (icell, cells) {
-
-      const Real cell_number_density = m_cell_number_density[icell];
-      ConstArrayView<Real> atom_fraction_av = m_atom_fraction[icell];
-      ConstArrayView<Integer> iso_gid_av = m_iso_gid[icell];
-      ArrayView<Real> total = m_total[icell];
-      Integer nIsotopes = iso_gid_av.size();
-
-      for (Integer energyGroup = 0; energyGroup < m_n_groups(); energyGroup++) {
-        Real sum = 0.0;
-
-        for (Integer isoIndex = 0; isoIndex < nIsotopes; isoIndex++) {
-          const Real atom_fraction = atom_fraction_av[isoIndex];
-          const Integer isotope_gid = iso_gid_av[isoIndex];
-          sum += macroscopicCrossSection(-1, cell_number_density, atom_fraction, isotope_gid, isoIndex, energyGroup);
-        }
-
-        total[energyGroup] = sum;
-      }
-    }
-  });
+  return weightedMacroscopicCrossSection(m_cell_number_density[cell], m_cell_material_index[cell], energyGroup);
 }
 
 /**
- * @brief Méthode permettant de déterminer la distance entre la particule p et la prochaine collision.
- * 
- * @param cell La cellule où se trouve la particule
+ * @brief Méthode permettant de calculer la section efficace macroscopique totale
+ * à partir de la densité et de l'indice de matériau d'une maille.
+ *
+ * @param cell_number_density La densité de la maille.
+ * @param material L'indice du matériau de la maille.
  * @param energyGroup Le groupe d'energie.
- * @return Real La distance entre la particule et la prochaine collision.
+ * @return Real La section efficace macroscopique totale.
  */
-void TrackingMCModule::
-weightedMacroscopicCrossSection(Cell cell, const Integer& energyGroup)
+Real TrackingMCModule::
+weightedMacroscopicCrossSection(Real cell_number_density, Integer material, const Integer& energyGroup)
 {
-  Real cell_number_density = m_cell_number_density[cell];
-  ConstArrayView<Real> atom_fraction_av = m_atom_fraction[cell];
-  ConstArrayView<Integer> iso_gid_av = m_iso_gid[cell];
-
-  Integer nIsotopes = iso_gid_av.size();
-  Real sum = 0.0;
-
-  for (Integer isoIndex = 0; isoIndex < nIsotopes; isoIndex++) {
-    const Real atom_fraction = atom_fraction_av[isoIndex];
-    const Integer isotope_gid = iso_gid_av[isoIndex];
-    sum += macroscopicCrossSection(-1, cell_number_density, atom_fraction, isotope_gid, isoIndex, energyGroup);
+  if (material < 0 || cell_number_density == 0.0) {
+    return 1e-20;
   }
 
-  m_total[cell][energyGroup] = sum;
+  return cell_number_density * m_cross_section_table.total(material, energyGroup);
 }
 
 /**
- * @brief Routine MacroscopicCrossSection calculates the number-density-weighted 
- * macroscopic cross section of a cell.
+ * @brief Méthode permettant de trouver la facet la plus proche de la particule p.
  * 
- * @param reactionIndex 
- * @param cell 
- * @param isoIndex 
- * @param energyGroup 
- * @return Real 
+ * @param particle La particule à étudier.
+ * @param node_coord Les coordonnées des nodes.
+ * @return DistanceToFacet Les caractéristiques de la facet la plus proche.
  */
-Real TrackingMCModule::
-macroscopicCrossSection(const Integer& reactionIndex,
-                        const Real& cell_number_density,
-                        const Real& atom_fraction,
-                        const Integer& isotope_gid,
-                        const Integer& isoIndex,
-                        const Integer& energyGroup)
+DistanceToFacet TrackingMCModule::
+getNearestFacet(Particle particle, VariableNodeReal3& node_coord)
 {
-  // The cell number density is the fraction of the atoms in cell
-  // volume of this isotope.  We set this (elsewhere) to 1/nIsotopes.
-  // This is a statement that we treat materials as if all of their
-  // isotopes are present in equal amounts
+  return getNearestFacet(particle.cell(), m_particle_coord[particle], m_particle_dir_cos[particle],
+                         m_particle_num_seg[particle], node_coord);
+}
 
-  if (atom_fraction == 0.0 || cell_number_density == 0.0) {
-    return 1e-20;
+/**
+ * @brief Méthode permettant de trouver la facet la plus proche d'une position,
+ * à partir du localId de la maille.
+ * Avec m_facet_geometry, les distances sont calculées sur les tableaux
+ * précalculés ; la maille n'est reconstruite que si la particule doit être
+ * recentrée (cf. findNearestFacet()).
+ *
+ * @param cell_lid Le localId de la cellule contenant la position.
+ * @param particle_coord La position de la particule (peut être déplacée).
+ * @param particle_dir_cos Les cosinus directeurs de la particule.
+ * @param particle_num_seg Le nombre de segments de la particule.
+ * @param node_coord Les coordonnées des nodes.
+ * @return DistanceToFacet Les caractéristiques de la facet la plus proche.
+ */
+DistanceToFacet TrackingMCModule::
+getNearestFacet(Int32 cell_lid, Real3& particle_coord, const Real3& particle_dir_cos,
+                const Real& particle_num_seg, VariableNodeReal3& node_coord)
+{
+  if (!m_use_facet_geometry) {
+    return getNearestFacet(Cell(m_cells_internal[cell_lid]), particle_coord, particle_dir_cos, particle_num_seg, node_coord);
   }
 
-  Real microscopicCrossSection = 0.0;
+  Integer iteration = 0;
+  Real move_factor = 0.5 * PhysicalConstants::_smallDouble;
+  DistanceToFacet nearest_facet;
+  Integer retry = 1;
+
+  Real plane_tolerance = 1e-16 * (particle_coord[MD_DirX] * particle_coord[MD_DirX] + particle_coord[MD_DirY] * particle_coord[MD_DirY] + particle_coord[MD_DirZ] * particle_coord[MD_DirZ]);
+
+  while (retry) {
+    Real distance[FacetGeometry::NB_FACET];
+    m_facet_geometry.computeDistances(cell_lid, plane_tolerance,
+                                      particle_coord, particle_dir_cos, distance);
+
+    DistanceToFacet distance_to_facet[FacetGeometry::NB_FACET];
+    for (Integer facet_index = 0; facet_index < FacetGeometry::NB_FACET; facet_index++) {
+      distance_to_facet[facet_index].distance = distance[facet_index];
+    }
 
-  if (reactionIndex < 0) {
-    // Return total cross section
-    microscopicCrossSection = m_nuclearData->getTotalCrossSection(isotope_gid, energyGroup);
+    nearest_facet = nearestFacet(distance_to_facet);
+    retry = 0;
+
+    // Cas rare : on passe par findNearestFacet() qui recentre la particule.
+    if (nearest_facet.distance == PhysicalConstants::_hugeDouble || nearest_facet.distance <= 0.0) {
+      nearest_facet = findNearestFacet(
+      Cell(m_cells_internal[cell_lid]), particle_coord, particle_num_seg,
+      iteration, move_factor,
+      distance_to_facet,
+      retry);
+    }
   }
-  else {
-    // Return the reaction cross section
-    microscopicCrossSection = m_nuclearData->getReactionCrossSection(reactionIndex,
-                                                                     isotope_gid, energyGroup);
+
+  if (nearest_facet.distance < 0) {
+    nearest_facet.distance = 0;
   }
 
-  return atom_fraction * cell_number_density * microscopicCrossSection;
+  ARCANE_ASSERT(nearest_facet.distance < PhysicalConstants::_hugeDouble, "nearest_facet.distance_to_facet >= PhysicalConstants::_hugeDouble");
+
+  return nearest_facet;
 }
 
 /**
- * @brief Méthode permettant de trouver la facet la plus proche de la particule p.
- * 
- * @param particle La particule à étudier.
+ * @brief Méthode permettant de trouver la facet la plus proche d'une position.
+ *
+ * @param cell La cellule contenant la position.
+ * @param particle_coord La position de la particule (peut être déplacée).
+ * @param particle_dir_cos Les cosinus directeurs de la particule.
+ * @param particle_num_seg Le nombre de segments de la particule.
  * @param node_coord Les coordonnées des nodes.
  * @return DistanceToFacet Les caractéristiques de la facet la plus proche.
  */
 DistanceToFacet TrackingMCModule::
-getNearestFacet(Particle particle, VariableNodeReal3& node_coord)
+getNearestFacet(Cell cell, Real3& particle_coord, const Real3& particle_dir_cos,
+                const Real& particle_num_seg, VariableNodeReal3& node_coord)
 {
-  Cell cell = particle.cell();
   Integer iteration = 0;
   Real move_factor = 0.5 * PhysicalConstants::_smallDouble;
   DistanceToFacet nearest_facet;
   Integer retry = 1;
 
-  Real plane_tolerance = 1e-16 * (m_particle_coord[particle][MD_DirX] * m_particle_coord[particle][MD_DirX] + m_particle_coord[particle][MD_DirY] * m_particle_coord[particle][MD_DirY] + m_particle_coord[particle][MD_DirZ] * m_particle_coord[particle][MD_DirZ]);
+  Real plane_tolerance = 1e-16 * (particle_coord[MD_DirX] * particle_coord[MD_DirX] + particle_coord[MD_DirY] * particle_coord[MD_DirY] + particle_coord[MD_DirZ] * particle_coord[MD_DirZ]);
 
   while (retry) // will break out when distance is found
   {
@@ -1163,52 +1622,62 @@ getNearestFacet(Particle particle, VariableNodeReal3& node_coord)
 
     DistanceToFacet distance_to_facet[24];
 
-    ENUMERATE_FACE (iface, cell.faces()) {
-      Face face = *iface;
-      Real3 point2(m_face_center_coord[iface]);
-
-      Integer index = iface.index();
-      Integer facet_index = index * 4;
-
-      Real dd = -1.0 *
-      (m_normal_face[index].x * point2.x +
-       m_normal_face[index].y * point2.y +
-       m_normal_face[index].z * point2.z);
-
-      Real facet_normal_dot_direction_cosine =
-      (m_normal_face[index].x * m_particle_dir_cos[particle][MD_DirA] +
-       m_normal_face[index].y * m_particle_dir_cos[particle][MD_DirB] +
-       m_normal_face[index].z * m_particle_dir_cos[particle][MD_DirG]);
-
-      // Consider only those facets whose outer normals have
-      // a positive dot product with the direction cosine.
-      // I.e. the particle is LEAVING the cell.
-      if (facet_normal_dot_direction_cosine <= 0.0) {
-        for (Integer i = 0; i < 4; i++) {
-          distance_to_facet[facet_index + i].distance = PhysicalConstants::_hugeDouble;
-        }
+    if (m_use_facet_geometry) {
+      Real distance[FacetGeometry::NB_FACET];
+      m_facet_geometry.computeDistances(cell.localId(), plane_tolerance,
+                                        particle_coord, particle_dir_cos, distance);
+      for (Integer facet_index = 0; facet_index < FacetGeometry::NB_FACET; facet_index++) {
+        distance_to_facet[facet_index].distance = distance[facet_index];
       }
-      else {
-        for (Integer i = 0; i < 4; i++) {
-
-          Node first_node = face.node(i);
-          Node second_node = face.node((i == 3) ? 0 : i + 1);
-
-          Real3 point0(node_coord[first_node]);
-          Real3 point1(node_coord[second_node]);
-
-          distance_to_facet[facet_index + i].distance = distanceToSegmentFacet(
-          plane_tolerance,
-          facet_normal_dot_direction_cosine,
-          m_normal_face[index].x, m_normal_face[index].y, m_normal_face[index].z, dd,
-          point2, point0, point1,
-          particle, false);
+    }
+    else {
+      ENUMERATE_FACE (iface, cell.faces()) {
+        Face face = *iface;
+        Real3 point2(m_face_center_coord[iface]);
+
+        Integer index = iface.index();
+        Integer facet_index = index * 4;
+
+        Real dd = -1.0 *
+        (m_normal_face[index].x * point2.x +
+         m_normal_face[index].y * point2.y +
+         m_normal_face[index].z * point2.z);
+
+        Real facet_normal_dot_direction_cosine =
+        (m_normal_face[index].x * particle_dir_cos[MD_DirA] +
+         m_normal_face[index].y * particle_dir_cos[MD_DirB] +
+         m_normal_face[index].z * particle_dir_cos[MD_DirG]);
+
+        // Consider only those facets whose outer normals have
+        // a positive dot product with the direction cosine.
+        // I.e. the particle is LEAVING the cell.
+        if (facet_normal_dot_direction_cosine <= 0.0) {
+          for (Integer i = 0; i < 4; i++) {
+            distance_to_facet[facet_index + i].distance = PhysicalConstants::_hugeDouble;
+          }
+        }
+        else {
+          for (Integer i = 0; i < 4; i++) {
+
+            Node first_node = face.node(i);
+            Node second_node = face.node((i == 3) ? 0 : i + 1);
+
+            Real3 point0(node_coord[first_node]);
+            Real3 point1(node_coord[second_node]);
+
+            distance_to_facet[facet_index + i].distance = FacetGeometry::distanceToSegmentFacet(
+            plane_tolerance,
+            facet_normal_dot_direction_cosine,
+            m_normal_face[index].x, m_normal_face[index].y, m_normal_face[index].z, dd,
+            point2, point0, point1,
+            particle_coord, particle_dir_cos, false);
+          }
         }
       }
     }
 
     nearest_facet = findNearestFacet(
-    particle,
+    cell, particle_coord, particle_num_seg,
     iteration, move_factor,
     distance_to_facet,
     retry);
@@ -1223,134 +1692,6 @@ getNearestFacet(Particle particle, VariableNodeReal3& node_coord)
   return nearest_facet;
 }
 
-/**
- * @brief Méthode permettant de trouver la distance entre une facet et une particule.
- * 
- * @param plane_tolerance 
- * @param facet_normal_dot_direction_cosine 
- * @param A 
- * @param B 
- * @param C 
- * @param D 
- * @param facet_coords0 
- * @param facet_coords1 
- * @param facet_coords2 
- * @param particle 
- * @param allow_enter 
- * @return Real 
- */
-Real TrackingMCModule::
-distanceToSegmentFacet(const Real& plane_tolerance,
-                       const Real& facet_normal_dot_direction_cosine,
-                       const Real& A, const Real& B, const Real& C, const Real& D,
-                       const Real3& facet_coords0,
-                       const Real3& facet_coords1,
-                       const Real3& facet_coords2,
-                       Particle particle,
-                       bool allow_enter)
-{
-  Real boundingBox_tolerance = 1e-9;
-  Real numerator = -1.0 * (A * m_particle_coord[particle][MD_DirX] + B * m_particle_coord[particle][MD_DirY] + C * m_particle_coord[particle][MD_DirZ] + D);
-
-  /* Plane equation: numerator = -P(x,y,z) = -(Ax + By + Cz + D)
-      if: numerator < -1e-8*length(x,y,z)   too negative!
-      if: numerator < 0 && numerator^2 > ( 1e-8*length(x,y,z) )^2   too negative!
-      reverse inequality since squaring function is decreasing for negative inputs.
-      If numerator is just SLIGHTLY negative, then the particle is just outside of the face */
-
-  // Filter out too negative distances
-  if (!allow_enter && numerator < 0.0 && numerator * numerator > plane_tolerance) {
-    return PhysicalConstants::_hugeDouble;
-  }
-
-  // we have to restrict the solution to within the triangular face
-  Real distance = numerator / facet_normal_dot_direction_cosine;
-
-  // see if the intersection point of the ray and the plane is within the triangular facet
-  Real3 intersection_pt;
-  intersection_pt.x = m_particle_coord[particle][MD_DirX] + distance * m_particle_dir_cos[particle][MD_DirA];
-  intersection_pt.y = m_particle_coord[particle][MD_DirY] + distance * m_particle_dir_cos[particle][MD_DirB];
-  intersection_pt.z = m_particle_coord[particle][MD_DirZ] + distance * m_particle_dir_cos[particle][MD_DirG];
-
-  // if the point is completely below the triangle, it is not in the triangle
-#define IF_POINT_BELOW_CONTINUE(axis) \
-  if (facet_coords0.axis > intersection_pt.axis + boundingBox_tolerance && \
-      facet_coords1.axis > intersection_pt.axis + boundingBox_tolerance && \
-      facet_coords2.axis > intersection_pt.axis + boundingBox_tolerance) { \
-    return PhysicalConstants::_hugeDouble; \
-  }
-
-#define IF_POINT_ABOVE_CONTINUE(axis) \
-  if (facet_coords0.axis < intersection_pt.axis - boundingBox_tolerance && \
-      facet_coords1.axis < intersection_pt.axis - boundingBox_tolerance && \
-      facet_coords2.axis < intersection_pt.axis - boundingBox_tolerance) { \
-    return PhysicalConstants::_hugeDouble; \
-  }
-
-  // Is the intersection point inside the triangular facet?  Project to 2D and see.
-
-  // A^2 + B^2 + C^2 = 1, so max(|A|,|B|,|C|) >= 1/sqrt(3) = 0.577
-  // (all coefficients can't be small)
-#define AB_CROSS_AC(ax, ay, bx, by, cx, cy) ((bx - ax) * (cy - ay) - (by - ay) * (cx - ax))
-  Real cross0 = 0, cross1 = 0, cross2 = 0;
-  if (C < -0.5 || C > 0.5) {
-    IF_POINT_BELOW_CONTINUE(x);
-    IF_POINT_ABOVE_CONTINUE(x);
-    IF_POINT_BELOW_CONTINUE(y);
-    IF_POINT_ABOVE_CONTINUE(y);
-
-    cross1 = AB_CROSS_AC(facet_coords0.x, facet_coords0.y,
-                         facet_coords1.x, facet_coords1.y,
-                         intersection_pt.x, intersection_pt.y);
-    cross2 = AB_CROSS_AC(facet_coords1.x, facet_coords1.y,
-                         facet_coords2.x, facet_coords2.y,
-                         intersection_pt.x, intersection_pt.y);
-    cross0 = AB_CROSS_AC(facet_coords2.x, facet_coords2.y,
-                         facet_coords0.x, facet_coords0.y,
-                         intersection_pt.x, intersection_pt.y);
-  }
-  else if (B < -0.5 || B > 0.5) {
-    IF_POINT_BELOW_CONTINUE(x);
-    IF_POINT_ABOVE_CONTINUE(x);
-    IF_POINT_BELOW_CONTINUE(z);
-    IF_POINT_ABOVE_CONTINUE(z);
-
-    cross1 = AB_CROSS_AC(facet_coords0.z, facet_coords0.x,
-                         facet_coords1.z, facet_coords1.x,
-                         intersection_pt.z, intersection_pt.x);
-    cross2 = AB_CROSS_AC(facet_coords1.z, facet_coords1.x,
-                         facet_coords2.z, facet_coords2.x,
-                         intersection_pt.z, intersection_pt.x);
-    cross0 = AB_CROSS_AC(facet_coords2.z, facet_coords2.x,
-                         facet_coords0.z, facet_coords0.x,
-                         intersection_pt.z, intersection_pt.x);
-  }
-  else if (A < -0.5 || A > 0.5) {
-    IF_POINT_BELOW_CONTINUE(z);
-    IF_POINT_ABOVE_CONTINUE(z);
-    IF_POINT_BELOW_CONTINUE(y);
-    IF_POINT_ABOVE_CONTINUE(y);
-
-    cross1 = AB_CROSS_AC(facet_coords0.y, facet_coords0.z,
-                         facet_coords1.y, facet_coords1.z,
-                         intersection_pt.y, intersection_pt.z);
-    cross2 = AB_CROSS_AC(facet_coords1.y, facet_coords1.z,
-                         facet_coords2.y, facet_coords2.z,
-                         intersection_pt.y, intersection_pt.z);
-    cross0 = AB_CROSS_AC(facet_coords2.y, facet_coords2.z,
-                         facet_coords0.y, facet_coords0.z,
-                         intersection_pt.y, intersection_pt.z);
-  }
-
-  Real cross_tol = 1e-9 * std::abs(cross0 + cross1 + cross2); // cross product tolerance
-
-  if ((cross0 > -cross_tol && cross1 > -cross_tol && cross2 > -cross_tol) ||
-      (cross0 < cross_tol && cross1 < cross_tol && cross2 < cross_tol)) {
-    return distance;
-  }
-  return PhysicalConstants::_hugeDouble;
-}
-
 /**
  * @brief Méthode permettant de trouver la facet la plus proche de la particule.
  * Cette méthode essaye de trouver la facet la plus proche en appelant nearestFacet.
@@ -1359,7 +1700,9 @@ distanceToSegmentFacet(const Real& plane_tolerance,
  * 
  */
 DistanceToFacet TrackingMCModule::
-findNearestFacet(Particle particle,
+findNearestFacet(Cell cell,
+                 Real3& particle_coord, // input/output
+                 const Real& particle_num_seg,
                  Integer& iteration, // input/output
                  Real& move_factor, // input/output
                  DistanceToFacet* distance_to_facet,
@@ -1372,19 +1715,17 @@ findNearestFacet(Particle particle,
   retry = 0;
 
   if ((nearest_facet.distance == PhysicalConstants::_hugeDouble && move_factor > 0) ||
-      (m_particle_num_seg[particle] > max_allowed_segments && nearest_facet.distance <= 0.0)) {
+      (particle_num_seg > max_allowed_segments && nearest_facet.distance <= 0.0)) {
 
     error() << "Attention, peut-être problème de facet.";
     error() << (nearest_facet.distance == PhysicalConstants::_hugeDouble) << " && " << (move_factor > 0)
-            << " || " << (m_particle_num_seg[particle] > max_allowed_segments) << " && " << (nearest_facet.distance <= 0.0);
+            << " || " << (particle_num_seg > max_allowed_segments) << " && " << (nearest_facet.distance <= 0.0);
 
     // Could not find a solution, so move the particle towards the center of the cell
     // and try again.
-    Cell cell = particle.cell();
-
-    m_particle_coord[particle][MD_DirX] += move_factor * (m_cell_center_coord[cell][MD_DirX] - m_particle_coord[particle][MD_DirX]);
-    m_particle_coord[particle][MD_DirY] += move_factor * (m_cell_center_coord[cell][MD_DirY] - m_particle_coord[particle][MD_DirY]);
-    m_particle_coord[particle][MD_DirZ] += move_factor * (m_cell_center_coord[cell][MD_DirZ] - m_particle_coord[particle][MD_DirZ]);
+    particle_coord[MD_DirX] += move_factor * (m_cell_center_coord[cell][MD_DirX] - particle_coord[MD_DirX]);
+    particle_coord[MD_DirY] += move_factor * (m_cell_center_coord[cell][MD_DirY] - particle_coord[MD_DirY]);
+    particle_coord[MD_DirZ] += move_factor * (m_cell_center_coord[cell][MD_DirZ] - particle_coord[MD_DirZ]);
 
     iteration++;
     move_factor *= 2.0;
@@ -1480,9 +1821,24 @@ findMin(UniqueArray<T> array)
  */
 void TrackingMCModule::
 rotate3DVector(Particle particle, const Real& sin_Theta, const Real& cos_Theta, const Real& sin_Phi, const Real& cos_Phi)
+{
+  rotate3DVector(m_particle_dir_cos[particle], sin_Theta, cos_Theta, sin_Phi, cos_Phi);
+}
+
+/**
+ * @brief Méthode permettant de faire une rotation à des cosinus directeurs.
+ *
+ * @param dir_cos Les cosinus directeurs à tourner.
+ * @param sin_Theta
+ * @param cos_Theta
+ * @param sin_Phi
+ * @param cos_Phi
+ */
+void TrackingMCModule::
+rotate3DVector(Real3& dir_cos, const Real& sin_Theta, const Real& cos_Theta, const Real& sin_Phi, const Real& cos_Phi)
 {
   // Calculate additional variables in the rotation matrix.
-  Real cos_theta = m_particle_dir_cos[particle][MD_DirG];
+  Real cos_theta = dir_cos[MD_DirG];
   Real sin_theta = sqrt((1.0 - (cos_theta * cos_theta)));
 
   Real cos_phi;
@@ -1493,12 +1849,12 @@ rotate3DVector(Particle particle, const Real& sin_Theta, const Real& cos_Theta,
     sin_phi = 0.0;
   }
   else {
-    cos_phi = m_particle_dir_cos[particle][MD_DirA] / sin_theta;
-    sin_phi = m_particle_dir_cos[particle][MD_DirB] / sin_theta;
+    cos_phi = dir_cos[MD_DirA] / sin_theta;
+    sin_phi = dir_cos[MD_DirB] / sin_theta;
   }
 
   // Calculate the rotated direction cosine
-  m_particle_dir_cos[particle][MD_DirA] = cos_theta * cos_phi * (sin_Theta * cos_Phi) - sin_phi * (sin_Theta * sin_Phi) + sin_theta * cos_phi * cos_Theta;
-  m_particle_dir_cos[particle][MD_DirB] = cos_theta * sin_phi * (sin_Theta * cos_Phi) + cos_phi * (sin_Theta * sin_Phi) + sin_theta * sin_phi * cos_Theta;
-  m_particle_dir_cos[particle][MD_DirG] = -sin_theta * (sin_Theta * cos_Phi) + cos_theta * cos_Theta;
+  dir_cos[MD_DirA] = cos_theta * cos_phi * (sin_Theta * cos_Phi) - sin_phi * (sin_Theta * sin_Phi) + sin_theta * cos_phi * cos_Theta;
+  dir_cos[MD_DirB] = cos_theta * sin_phi * (sin_Theta * cos_Phi) + cos_phi * (sin_Theta * sin_Phi) + sin_theta * sin_phi * cos_Theta;
+  dir_cos[MD_DirG] = -sin_theta * (sin_Theta * cos_Phi) + cos_theta * cos_Theta;
 }
@@ -14,6 +14,7 @@
 #include "structEnum.hh"
 #include <arcane/IAsyncParticleExchanger.h>
 #include <arcane/IItemFamily.h>
+#include <arcane/ILoadBalanceMng.h>
 #include <arcane/IMesh.h>
 #include <arcane/IParallelMng.h>
 #include <arcane/IParticleExchanger.h>
@@ -28,11 +29,17 @@
 #include <arcane/materials/MeshMaterialVariableRef.h>
 #include <arccore/concurrency/Mutex.h>
 #include "ISimpleOutput.hh"
+#include "PerfStats.hh"
 #include <arcane/ServiceBuilder.h>
 
 #include "TrackingMC_axl.h"
 
 #include "NuclearData.hh"
+#include "CollisionStaging.hh"
+#include "CrossSectionTable.hh"
+#include "FacetGeometry.hh"
+#include "ParticleSoA.hh"
+#include "TrackingTally.hh"
 
 using namespace Arcane;
 using namespace Arcane::Materials;
@@ -64,17 +71,13 @@ class TrackingMCModule : public ArcaneTrackingMCObject
   , m_particle_family(nullptr)
   , m_material_mng(nullptr)
   , m_timer(nullptr)
+  , m_timer_compute(nullptr)
+  , m_timer_exchange(nullptr)
+  , m_timer_update(nullptr)
+  , m_timer_compaction(nullptr)
   , m_nuclearData(nullptr)
   , m_exited_particles_local_ids(0)
   , m_extra_particles_local_ids(0)
-  , m_extra_particles_particle_src(0)
-  , m_extra_particles_cellid_dst(0)
-  , m_extra_particles_global_id(0)
-  , m_extra_particles_rns(0)
-  , m_extra_particles_energy_out(0)
-  , m_extra_particles_angle_out(0)
-  , m_extra_particles_energy_out_particle_src(0)
-  , m_extra_particles_angle_out_particle_src(0)
   , m_outgoing_particles_local_ids(0)
   , m_outgoing_particles_rank_to(0)
   {}
@@ -82,6 +85,7 @@ class TrackingMCModule : public ArcaneTrackingMCObject
  public:
   void initModule() override;
   void cycleTracking() override;
+  void onMeshChanged() override;
   void endModule() override;
 
   VersionInfo versionInfo() const override { return VersionInfo(1, 3, 0); }
@@ -92,71 +96,96 @@ class TrackingMCModule : public ArcaneTrackingMCObject
   IMeshMaterialMng* m_material_mng;
   NuclearData* m_nuclearData;
   Timer* m_timer;
+  // Temps des phases du tracking (calcul / échanges / mises à jour de la
+  // famille / compaction).
+  Timer* m_timer_compute;
+  Timer* m_timer_exchange;
+  Timer* m_timer_update;
+  Timer* m_timer_compaction;
+  Integer m_nb_sub_iterations = 0;
+  // Temps de chaque sous-itération du sous-domaine (mode sync), et nombre de
+  // sous-itérations ayant déjà une ligne dans le csv.
+  RealUniqueArray m_sub_iteration_compute_times;
+  RealUniqueArray m_sub_iteration_update_times;
+  RealUniqueArray m_sub_iteration_exchange_times;
+  Integer m_nb_sub_iteration_rows = 0;
+  Integer m_nb_csv_cycles = 0;
+
+  // Fonctions de répartition des réactions par matériau (cf. m_cell_material_index).
+  CrossSectionTable m_cross_section_table;
 
   Int32UniqueArray m_exited_particles_local_ids;
 
   // Les particules "extra" sont les particules qui n'ont pas fini leur itération
   // (et donc necessite une autre sous-itération).
   Int32UniqueArray m_extra_particles_local_ids;
-  Int32UniqueArray m_extra_particles_particle_src; //Particle localId source
-  Int32UniqueArray m_extra_particles_cellid_dst; //Cell localId dst
-  Int64UniqueArray m_extra_particles_global_id; //Futur globalId
-  Int64UniqueArray m_extra_particles_rns; //Futur RNS
-  RealUniqueArray m_extra_particles_energy_out; //updateTrajectory
-  RealUniqueArray m_extra_particles_angle_out; //updateTrajectory
-  RealUniqueArray m_extra_particles_energy_out_particle_src; //updateTrajectory
-  RealUniqueArray m_extra_particles_angle_out_particle_src; //updateTrajectory
+
+  // Produits des collisions (par thread), consommés par collisionEventSuite().
+  CollisionStagingArena m_collision_staging;
 
   Int32UniqueArray m_outgoing_particles_local_ids;
   Int32UniqueArray m_outgoing_particles_rank_to;
 
-  std::atomic<Int64> m_num_segments_a{ 0 };
-  std::atomic<Int64> m_escape_a{ 0 };
-  std::atomic<Int64> m_census_a{ 0 };
-  std::atomic<Int64> m_collision_a{ 0 };
-  std::atomic<Int64> m_scatter_a{ 0 };
-  std::atomic<Int64> m_fission_a{ 0 };
-  std::atomic<Int64> m_absorb_a{ 0 };
-  std::atomic<Int64> m_produce_a{ 0 };
+  // Compteurs d'événements et flux scalaire, par thread.
+  TrackingCounters m_counters;
+  ScalarFluxTally m_flux_tally;
+
+  // Charge des threads pendant le suivi, et taille des lots répartis entre
+  // les threads (trackingGrainSize, moteurs history et event).
+  TrackingThreadLoads m_thread_loads;
+  ParallelLoopOptions m_tracking_loop_options;
+
+  // Segments suivis par maille (critère d'équilibrage, si segmentLoadBalance).
+  CellWorkTally m_cell_work;
+  bool m_use_segment_criterion = false;
 
   GlobalMutex m_mutex_exit;
-  GlobalMutex m_mutex_extra;
   GlobalMutex m_mutex_out;
-  GlobalMutex m_mutex_flux;
+
+  // Facets précalculées des mailles (si geometryEngine = packed).
+  FacetGeometry m_facet_geometry;
+  bool m_use_facet_geometry = false;
+
+  // Etat des particules pour le moteur de tracking par événements.
+  ParticleSoA m_soa;
+  ItemInternalList m_cells_internal;
 
  protected:
   void tracking();
+  void trackingAsync(IAsyncParticleExchanger* ae, ParticleVectorView particles, VariableNodeReal3& node_coord);
+  void trackParticles(ParticleVectorView particles, VariableNodeReal3& node_coord);
+  void sortParticlesByCost(ParticleVectorView particles, Int32Array& sorted_local_ids);
   void updateTallies();
+  void addSubIterationRows(ISimpleOutput* csv, IParallelMng* pm);
+  void initFluxTallyScale(ParticleVectorView particles);
   void initNuclearData();
+  void initFacetGeometry();
   bool isInGeometry(const Integer& pos, Cell cell);
   void cycleTrackingGuts(Particle particle, VariableNodeReal3& node_coord);
   void cycleTrackingFunction(Particle particle, VariableNodeReal3& node_coord);
   void collisionEventSuite();
   void computeNextEvent(Particle particle, VariableNodeReal3& node_coord);
   Integer collisionEvent(Particle particle);
+  NuclearDataReaction& sampleReaction(Cell cell, const Integer& energy_group, Int64* rns);
+  NuclearDataReaction& sampleReaction(Integer material, const Integer& energy_group, Int64* rns);
   void facetCrossingEvent(Particle particle);
   void reflectParticle(Particle particle, VariableNodeReal3& node_coord);
-  void cloneParticles(Int32UniqueArray idsSrc, Int32UniqueArray idsNew, Int64UniqueArray rnsNew);
+  void reflectParticle(const Integer& face_index, Real3& dir_cos, Real3& velocity);
+  void cloneParticles(ConstArrayView<SecondaryParticle> secondaries, ConstArrayView<Int32> new_local_ids);
   void cloneParticle(Particle pSrc, Particle pNew, const Int64& rns);
   void updateTrajectory(const Real& energy, const Real& angle, Particle particle);
-  void computeCrossSection();
-  void weightedMacroscopicCrossSection(Cell cell, const Integer& energyGroup);
-  Real macroscopicCrossSection(const Integer& reactionIndex,
-                               const Real& cell_number_density,
-                               const Real& atom_fraction,
-                               const Integer& isotopeGid,
-                               const Integer& isoIndex,
-                               const Integer& energyGroup);
+  void updateTrajectory(const Real& energy, const Real& angle, Real& kin_ene,
+                        Real3& dir_cos, Real3& velocity, Real& num_mean_free_path, Int64* rns);
+  Real weightedMacroscopicCrossSection(Cell cell, const Integer& energyGroup);
+  Real weightedMacroscopicCrossSection(Real cell_number_density, Integer material, const Integer& energyGroup);
   DistanceToFacet getNearestFacet(Particle particle, VariableNodeReal3& node_coord);
-  Real distanceToSegmentFacet(const Real& plane_tolerance,
-                              const Real& facet_normal_dot_direction_cosine,
-                              const Real& A, const Real& B, const Real& C, const Real& D,
-                              const Real3& facet_coords0,
-                              const Real3& facet_coords1,
-                              const Real3& facet_coords2,
-                              Particle particle,
-                              bool allow_enter);
-  DistanceToFacet findNearestFacet(Particle particle,
+  DistanceToFacet getNearestFacet(Cell cell, Real3& particle_coord, const Real3& particle_dir_cos,
+                                  const Real& particle_num_seg, VariableNodeReal3& node_coord);
+  DistanceToFacet getNearestFacet(Int32 cell_lid, Real3& particle_coord, const Real3& particle_dir_cos,
+                                  const Real& particle_num_seg, VariableNodeReal3& node_coord);
+  DistanceToFacet findNearestFacet(Cell cell,
+                                   Real3& particle_coord,
+                                   const Real& particle_num_seg,
                                    Integer& iteration,
                                    Real& move_factor,
                                    DistanceToFacet* distance_to_facet,
@@ -165,6 +194,16 @@ class TrackingMCModule : public ArcaneTrackingMCObject
   template <typename T>
   Integer findMin(UniqueArray<T> array);
   void rotate3DVector(Particle particle, const Real& sin_Theta, const Real& cos_Theta, const Real& sin_Phi, const Real& cos_Phi);
+  void rotate3DVector(Real3& dir_cos, const Real& sin_Theta, const Real& cos_Theta, const Real& sin_Phi, const Real& cos_Phi);
+
+  // Moteur de tracking par événements (TrackingMCEvent.cc).
+  void trackingEventBased(ParticleVectorView particles, VariableNodeReal3& node_coord);
+  void loadParticleSoA(ParticleVectorView particles);
+  void storeParticleSoA(ParticleVectorView particles);
+  void computeNextEventBatch(ConstArrayView<Int32> batch, VariableNodeReal3& node_coord);
+  void censusEventBatch(ConstArrayView<Int32> batch);
+  void collisionEventBatch(ConstArrayView<Int32> batch, Int32Array& active);
+  void facetCrossingEventBatch(ConstArrayView<Int32> batch, Int32Array& active);
 };
 
 /*---------------------------------------------------------------------------*/
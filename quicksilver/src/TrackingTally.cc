@@ -0,0 +1,185 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* TrackingTally.cc                                            (C) 2000-2022 */
+/*                                                                           */
+/* Tallies par thread du tracking QAMA                                       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "TrackingTally.hh"
+#include <arcane/IItemFamily.h>
+#include <arcane/ItemGroup.h>
+#include <arcane/utils/FatalErrorException.h>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Méthode permettant d'allouer les tableaux du tally.
+ *
+ * @param nb_cell Le nombre de mailles (maxLocalId() de la famille).
+ * @param nb_group Le nombre de groupes d'énergie.
+ * @param mode Le mode d'accumulation.
+ */
+void ScalarFluxTally::
+init(Integer nb_cell, Integer nb_group, eFluxTallyMode mode)
+{
+  m_mode = mode;
+  m_nb_cell = nb_cell;
+  m_nb_group = nb_group;
+
+  m_overflow.store(false, std::memory_order_relaxed);
+
+  const Int64 size = static_cast<Int64>(nb_cell) * nb_group;
+
+  if (m_mode == eFluxTallyMode::ATOMIC) {
+    m_thread_blocks.clear();
+    m_sum.clear();
+    m_atomic_sum.reset(new std::atomic<Int64>[size]);
+    for (Int64 i = 0; i < size; i++) {
+      m_atomic_sum[i].store(0, std::memory_order_relaxed);
+    }
+  }
+  else {
+    m_atomic_sum.reset();
+
+    // Seule la table des blocs est dense par thread (1 Int32 pour
+    // BLOCK_SIZE entrées) ; les blocs sont alloués à la première écriture.
+    const Int64 nb_block = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    m_thread_blocks.resize(TaskFactory::nbAllowedThread() + 1);
+    for (ThreadBlocks& blocks : m_thread_blocks) {
+      blocks.slot.resize(nb_block);
+      blocks.slot.fill(-1);
+      blocks.data.clear();
+    }
+    m_sum.resize(size);
+    m_sum.fill(0);
+  }
+}
+
+/**
+ * @brief Méthode permettant de calculer le facteur d'échelle de la virgule fixe.
+ * Le facteur est la plus grande puissance de deux telle que
+ * flux_bound * facteur < 2^62 : une somme peut donc dépasser flux_bound
+ * d'un facteur 2 avant de ne plus tenir dans un Int64. Au-delà, le
+ * dépassement est détecté par add()/merge() et flush() s'arrête en erreur.
+ * flux_bound doit être identique sur tous les sous-domaines (réduction
+ * globale) pour que les tallies restent comparables entre eux.
+ * A n'appeler que lorsque les sommes sont nulles (après flush()).
+ *
+ * @param flux_bound Une borne supérieure de la somme des contributions.
+ */
+void ScalarFluxTally::
+computeScale(Real flux_bound)
+{
+  if (flux_bound > 0.0) {
+    m_scale = std::ldexp(1.0, 61 - std::ilogb(flux_bound));
+  }
+  else {
+    m_scale = 1.0;
+  }
+}
+
+/**
+ * @brief Méthode permettant de fusionner les blocs des threads.
+ * Seuls les blocs touchés depuis le dernier merge() sont parcourus puis
+ * rendus. En mode ATOMIC, le tableau partagé est déjà à jour.
+ */
+void ScalarFluxTally::
+merge()
+{
+  if (m_mode == eFluxTallyMode::ATOMIC) {
+    return;
+  }
+
+  // Parallélisation sur les blocs de m_sum : deux tâches n'écrivent
+  // jamais dans le même bloc.
+  const Integer nb_block = (m_thread_blocks.empty() ? 0 : m_thread_blocks[0].slot.size());
+
+  arcaneParallelFor(0, nb_block, [&](Integer begin, Integer size) {
+    bool overflow = false;
+    for (Integer block = begin; block < (begin + size); block++) {
+      const Int64 first = static_cast<Int64>(block) * BLOCK_SIZE;
+      const Int64 nb_entry = std::min(static_cast<Int64>(BLOCK_SIZE), m_sum.largeSize() - first);
+      Int64* dst = m_sum.data() + first;
+
+      for (ThreadBlocks& blocks : m_thread_blocks) {
+        const Int32 slot = blocks.slot[block];
+        if (slot < 0) {
+          continue;
+        }
+        const Int64* src = blocks.data.data() + static_cast<Int64>(slot) * BLOCK_SIZE;
+        for (Int64 i = 0; i < nb_entry; i++) {
+          overflow |= (dst[i] > std::numeric_limits<Int64>::max() - src[i]);
+          dst[i] += src[i];
+        }
+        blocks.slot[block] = -1;
+      }
+    }
+    if (overflow) {
+      m_overflow.store(true, std::memory_order_relaxed);
+    }
+  });
+
+  for (ThreadBlocks& blocks : m_thread_blocks) {
+    blocks.data.clear();
+  }
+}
+
+/**
+ * @brief Méthode permettant d'ajouter les sommes au tally Arcane puis de
+ * les remettre à zéro.
+ *
+ * @param scalar_flux_tally Le tally à mettre à jour.
+ * @param cells Les mailles à mettre à jour.
+ */
+void ScalarFluxTally::
+flush(VariableCellArrayReal& scalar_flux_tally, CellGroup cells)
+{
+  merge();
+
+  if (m_overflow.load(std::memory_order_relaxed)) {
+    ARCANE_FATAL("Dépassement du tally de flux en virgule fixe : la borne donnée à computeScale() est trop petite.");
+  }
+
+  const Real inv_scale = 1.0 / m_scale;
+
+  ENUMERATE_CELL (icell, cells) {
+    const Int64 begin = static_cast<Int64>(icell.localId()) * m_nb_group;
+    for (Integer group = 0; group < m_nb_group; group++) {
+      Int64 fixed_value;
+      if (m_mode == eFluxTallyMode::ATOMIC) {
+        fixed_value = m_atomic_sum[begin + group].exchange(0, std::memory_order_relaxed);
+      }
+      else {
+        fixed_value = m_sum[begin + group];
+        m_sum[begin + group] = 0;
+      }
+      scalar_flux_tally[icell][group] += static_cast<Real>(fixed_value) * inv_scale;
+    }
+  }
+}
+
+/**
+ * @brief Méthode permettant de copier les compteurs dans le critère puis de
+ * les remettre à zéro. Chaque maille compte au moins pour un segment pour
+ * que les mailles vides gardent un poids dans le partitionnement.
+ *
+ * @param criterion Le critère d'équilibrage à mettre à jour.
+ * @param cells Les mailles à mettre à jour.
+ */
+void CellWorkTally::
+flush(VariableCellReal& criterion, CellGroup cells)
+{
+  ENUMERATE_CELL (icell, cells) {
+    criterion[icell] = 1.0 + m_nb_segment[icell.localId()].exchange(0, std::memory_order_relaxed);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,278 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* TrackingTally.hh                                            (C) 2000-2022 */
+/*                                                                           */
+/* Tallies par thread du tracking QAMA                                       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef TRACKINGTALLY_HH
+#define TRACKINGTALLY_HH
+
+#include "structEnum.hh"
+#include <arcane/Concurrency.h>
+#include <arcane/VariableTypes.h>
+#include <arcane/utils/PlatformUtils.h>
+#include <arcane/utils/UniqueArray.h>
+#include <arccore/collections/IMemoryAllocator.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+using namespace Arcane;
+
+/**
+ * @brief Compteurs des événements du tracking.
+ * La structure fait exactement une ligne de cache pour que deux threads
+ * n'écrivent jamais dans la même ligne.
+ */
+struct alignas(64) TrackingEventCounters
+{
+  Int64 num_segments = 0;
+  Int64 escape = 0;
+  Int64 census = 0;
+  Int64 collision = 0;
+  Int64 scatter = 0;
+  Int64 fission = 0;
+  Int64 absorb = 0;
+  Int64 produce = 0;
+
+  TrackingEventCounters& operator+=(const TrackingEventCounters& other)
+  {
+    num_segments += other.num_segments;
+    escape += other.escape;
+    census += other.census;
+    collision += other.collision;
+    scatter += other.scatter;
+    fission += other.fission;
+    absorb += other.absorb;
+    produce += other.produce;
+    return *this;
+  }
+};
+
+/**
+ * @brief Classe contenant un jeu de compteurs par thread.
+ * L'indice 0 est réservé au thread principal hors tâche
+ * (TaskFactory::currentTaskThreadIndex() == -1).
+ */
+class TrackingCounters
+{
+ public:
+  void init()
+  {
+    m_counters = UniqueArray<TrackingEventCounters>(AlignedMemoryAllocator::CacheLine(),
+                                                    TaskFactory::nbAllowedThread() + 1);
+    reset();
+  }
+
+  //! Compteurs du thread courant.
+  TrackingEventCounters& local()
+  {
+    return m_counters[TaskFactory::currentTaskThreadIndex() + 1];
+  }
+
+  //! Somme des compteurs de tous les threads.
+  TrackingEventCounters sum() const
+  {
+    TrackingEventCounters total;
+    for (const TrackingEventCounters& counters : m_counters) {
+      total += counters;
+    }
+    return total;
+  }
+
+  void reset()
+  {
+    m_counters.fill(TrackingEventCounters());
+  }
+
+ private:
+  UniqueArray<TrackingEventCounters> m_counters;
+};
+
+/**
+ * @brief Charge d'un thread pendant le suivi des particules.
+ */
+struct alignas(64) TrackingThreadLoad
+{
+  Int64 nb_particle = 0; //!< Nombre de particules suivies.
+  Int64 nb_batch = 0; //!< Nombre de lots traités.
+  Real busy_time = 0.0; //!< Temps passé à suivre des particules (en s).
+
+  //! Ajoute un lot de nb particules suivi depuis begin_time.
+  void addBatch(Integer nb, Real begin_time)
+  {
+    nb_particle += nb;
+    nb_batch++;
+    busy_time += platform::getRealTime() - begin_time;
+  }
+};
+
+/**
+ * @brief Classe contenant la charge de chaque thread.
+ * Même indexation que TrackingCounters.
+ */
+class TrackingThreadLoads
+{
+ public:
+  void init()
+  {
+    m_loads = UniqueArray<TrackingThreadLoad>(AlignedMemoryAllocator::CacheLine(),
+                                              TaskFactory::nbAllowedThread() + 1);
+    reset();
+  }
+
+  //! Charge du thread courant.
+  TrackingThreadLoad& local()
+  {
+    return m_loads[TaskFactory::currentTaskThreadIndex() + 1];
+  }
+
+  ConstArrayView<TrackingThreadLoad> loads() const { return m_loads; }
+
+  //! Rapport entre le temps du thread le plus chargé et le temps moyen (1 si équilibré).
+  Real imbalance() const
+  {
+    Real max_time = 0.0;
+    Real sum_time = 0.0;
+    for (const TrackingThreadLoad& load : m_loads) {
+      max_time = std::max(max_time, load.busy_time);
+      sum_time += load.busy_time;
+    }
+    const Integer nb_thread = std::max(TaskFactory::nbAllowedThread(), 1);
+    return (sum_time > 0.0 ? max_time * nb_thread / sum_time : 1.0);
+  }
+
+  void reset()
+  {
+    m_loads.fill(TrackingThreadLoad());
+  }
+
+ private:
+  UniqueArray<TrackingThreadLoad> m_loads;
+};
+
+/**
+ * @brief Classe permettant de compter les segments suivis dans chaque maille.
+ * Les compteurs sont atomiques (une maille est rarement mise à jour par deux
+ * threads en même temps). Sert de critère d'équilibrage de charge.
+ */
+class CellWorkTally
+{
+ public:
+  void init(Integer nb_cell)
+  {
+    m_nb_segment.reset(new std::atomic<Int32>[nb_cell]);
+    for (Integer i = 0; i < nb_cell; i++) {
+      m_nb_segment[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  //! Ajoute nb_segment segments à la maille cell_lid.
+  void add(Int32 cell_lid, Int32 nb_segment = 1)
+  {
+    m_nb_segment[cell_lid].fetch_add(nb_segment, std::memory_order_relaxed);
+  }
+
+  void flush(VariableCellReal& criterion, CellGroup cells);
+
+ private:
+  std::unique_ptr<std::atomic<Int32>[]> m_nb_segment;
+};
+
+/**
+ * @brief Classe permettant d'accumuler le flux scalaire sans verrou.
+ * Les contributions sont converties en entiers (virgule fixe) avant d'être
+ * sommées : l'addition entière étant associative, le résultat ne dépend ni
+ * du nombre de threads ni de l'ordre de traitement des particules.
+ * Le facteur d'échelle est une puissance de deux calculée à partir d'une
+ * borne globale du flux (cf. computeScale()). Un dépassement de cette borne
+ * est détecté à l'accumulation et provoque une erreur fatale dans flush()
+ * (pas de somme fausse silencieuse).
+ *
+ * Deux modes sont disponibles :
+ * - PRIVATIZED : chaque thread n'alloue que les blocs de BLOCK_SIZE
+ *   entrées qu'il touche ; merge() ne parcourt que ces blocs,
+ * - ATOMIC : un seul tableau partagé mis à jour par des fetch_add.
+ */
+class ScalarFluxTally
+{
+ public:
+  //! Nombre d'entrées (maille, groupe) d'un bloc privatisé (4 Ko).
+  static constexpr Int32 BLOCK_SIZE = 512;
+
+ public:
+  void init(Integer nb_cell, Integer nb_group, eFluxTallyMode mode);
+
+  void computeScale(Real flux_bound);
+
+  //! Ajoute la contribution value à la maille cell_lid pour le groupe group.
+  void add(Int32 cell_lid, Integer group, Real value)
+  {
+    const Int64 fixed_value = static_cast<Int64>(std::llround(value * m_scale));
+    const Int64 pos = static_cast<Int64>(cell_lid) * m_nb_group + group;
+
+    if (m_mode == eFluxTallyMode::ATOMIC) {
+      const Int64 old_value = m_atomic_sum[pos].fetch_add(fixed_value, std::memory_order_relaxed);
+      if (old_value > std::numeric_limits<Int64>::max() - fixed_value) {
+        m_overflow.store(true, std::memory_order_relaxed);
+      }
+    }
+    else {
+      ThreadBlocks& blocks = m_thread_blocks[TaskFactory::currentTaskThreadIndex() + 1];
+      Int64& sum = blocks.entry(pos);
+      if (sum > std::numeric_limits<Int64>::max() - fixed_value) {
+        m_overflow.store(true, std::memory_order_relaxed);
+      }
+      sum += fixed_value;
+    }
+  }
+
+  void merge();
+  void flush(VariableCellArrayReal& scalar_flux_tally, CellGroup cells);
+
+ private:
+  /**
+   * @brief Blocs touchés par un thread.
+   * slot[b] est la position du bloc b dans data (-1 si non touché).
+   */
+  struct ThreadBlocks
+  {
+    Int32UniqueArray slot;
+    Int64UniqueArray data;
+
+    Int64& entry(Int64 pos)
+    {
+      const Int32 block = static_cast<Int32>(pos / BLOCK_SIZE);
+      Int32 s = slot[block];
+      if (s < 0) {
+        const Int64 old_size = data.largeSize();
+        s = static_cast<Int32>(old_size / BLOCK_SIZE);
+        slot[block] = s;
+        data.resize(old_size + BLOCK_SIZE);
+        data.subView(old_size, BLOCK_SIZE).fill(0);
+      }
+      return data[static_cast<Int64>(s) * BLOCK_SIZE + pos % BLOCK_SIZE];
+    }
+  };
+
+  eFluxTallyMode m_mode = eFluxTallyMode::PRIVATIZED;
+  Integer m_nb_cell = 0;
+  Integer m_nb_group = 0;
+  Real m_scale = 1.0;
+  std::atomic<bool> m_overflow{ false };
+
+  UniqueArray<ThreadBlocks> m_thread_blocks;
+  Int64UniqueArray m_sum;
+  std::unique_ptr<std::atomic<Int64>[]> m_atomic_sum;
+};
+
+#endif
@@ -33,6 +33,49 @@ enum eShape
   SPHERE
 };
 
+enum eTrackingEngine
+{
+  HISTORY, // Une particule est suivie jusqu'à la fin de son itération.
+  EVENT // Les particules sont suivies par lots d'événements.
+};
+
+enum eFluxTallyMode
+{
+  PRIVATIZED, // Un tableau par thread, fusionné à chaque sous-itération.
+  ATOMIC // Un tableau partagé mis à jour de manière atomique.
+};
+
+enum eExchangeMode
+{
+  SYNC, // Echange bloquant + réduction à chaque sous-itération.
+  ASYNC // Echange asynchrone (IAsyncParticleExchanger).
+};
+
+enum eGeometryEngine
+{
+  LEGACY, // Facets recalculées à partir du maillage à chaque recherche.
+  PACKED // Facets précalculées par maille (FacetGeometry).
+};
+
+enum eRngKind
+{
+  LCG, // Générateur congruentiel linéaire d'origine.
+  PHILOX // Générateur à compteur (Philox2x32-10).
+};
+
+enum eParticleSort
+{
+  SORT_NONE, // Pas de tri des particules.
+  SORT_CELL, // Tri par localId de maille.
+  SORT_MORTON // Tri selon l'ordre de Morton du centre des mailles.
+};
+
+enum eCsvMode
+{
+  CSV_MEMORY, // Tableau gardé en mémoire et écrit à la fin (une colonne par itération).
+  CSV_STREAM // Une ligne par itération, écrite au fil de l'eau.
+};
+
 enum CosDir
 {
   MD_DirA = 0, // Alpha